@@ -60,7 +60,8 @@ int main(int argc, char **argv) {
 #else
     MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, NULL);
 #endif
-    if(argc < 7 || argc > 10) {
+    HPDDM::Option::get().parse(argc, argv);
+    if(argc < 7) {
         int rankWorld;
         MPI_Comm_rank(MPI_COMM_WORLD, &rankWorld);
         if(rankWorld == 0) {
@@ -404,8 +405,8 @@ int main(int argc, char **argv) {
             A.setType(0);
             /*# Factorization #*/
             std::vector<unsigned short> parm(5);
-            parm[HPDDM::P] = 1;
-            parm[HPDDM::TOPOLOGY] = 0;
+            parm[HPDDM::P] = HPDDM::Option::get().val<unsigned short>("p", 1);
+            parm[HPDDM::TOPOLOGY] = HPDDM::Option::get().val<unsigned short>("topology", 0);
             if(std::find(arguments.begin() + 6, arguments.end(), "-distributed_sol") != arguments.end()) {
                 if(std::find(arguments.begin() + 6, arguments.end(), "-distributed_rhs") != arguments.end())
                     parm[HPDDM::DISTRIBUTION] = HPDDM::DMatrix::DISTRIBUTED_SOL_AND_RHS;
@@ -428,6 +429,8 @@ int main(int argc, char **argv) {
             }
             A.super::initialize(parm[HPDDM::NU]);
             A.buildTwo(MPI_COMM_WORLD, parm);
+            if(std::find(arguments.begin() + 6, arguments.end(), "-compressed") != arguments.end())
+                A.compressVectors(HPDDM_EPS, true);
             A.callNumfact();
             /*# FactorizationEnd #*/
             /*# Solution #*/
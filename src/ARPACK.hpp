@@ -81,9 +81,11 @@ class Arpack : public Eigensolver<K> {
          *    A              - Left-hand side matrix.
          *    B              - Right-hand side matrix.
          *    ev             - Array of eigenvectors.
-         *    communicator   - MPI communicator for selecting the threshold criterion. */
+         *    communicator   - MPI communicator for selecting the threshold criterion.
+         *    s              - Solver used for the shift-and-invert spectral transformation (optional).
+         *    warm           - Number of eigenvectors from a previous call stored in _ev_ used to build the initial residual (optional). */
         template<template<class> class Solver>
-        inline void solve(MatrixCSR<K>* const& A, MatrixCSR<K>* const& B, K**& ev, const MPI_Comm& communicator, Solver<K>* const& s = nullptr) {
+        inline void solve(MatrixCSR<K>* const& A, MatrixCSR<K>* const& B, K**& ev, const MPI_Comm& communicator, Solver<K>* const& s = nullptr, const unsigned short warm = 0) {
             int ido = 0;
             char bmat = 'G';
             int iparam[11] = { 1, 0, _it, 1, 0, 0, 3, 0, 0, 0, 0 };
@@ -108,6 +110,17 @@ class Arpack : public Eigensolver<K> {
                 rwork = new typename Wrapper<K>::ul_type[Eigensolver<K>::_n];
             int info = 0;
             K* vresid = vp + ncv * Eigensolver<K>::_n;
+            if(warm && ev && *ev) {
+                std::fill(vresid, vresid + Eigensolver<K>::_n, K());
+                for(unsigned short i = 0; i < warm; ++i)
+                    Wrapper<K>::axpy(&(Eigensolver<K>::_n), &(Wrapper<K>::d__1), *ev + i * Eigensolver<K>::_n, &i__1, vresid, &i__1);
+                info = 1;
+            }
+            if(ev) {
+                delete [] *ev;
+                delete [] ev;
+                ev = nullptr;
+            }
             Solver<K>* const prec = s ? s : new Solver<K>;
 #if defined(MUMPSSUB)
             prec->numfact(A, false);
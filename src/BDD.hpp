@@ -55,14 +55,14 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             super::template initialize<false>();
             _m = new typename Wrapper<K>::ul_type[Subdomain<K>::_dof];
         }
-        inline void allocateSingle(K*& primal) const {
-            primal = new K[Subdomain<K>::_dof];
+        inline void allocateSingle(K*& primal, const unsigned short& mu = 1) const {
+            primal = new K[mu * Subdomain<K>::_dof];
         }
         template<unsigned short N>
-        inline void allocateArray(K* (&array)[N]) const {
-            *array = new K[N * Subdomain<K>::_dof];
+        inline void allocateArray(K* (&array)[N], const unsigned short& mu = 1) const {
+            *array = new K[N * mu * Subdomain<K>::_dof];
             for(unsigned short i = 1; i < N; ++i)
-                array[i] = *array + i * Subdomain<K>::_dof;
+                array[i] = *array + i * mu * Subdomain<K>::_dof;
         }
         /* Function: buildScaling
          *
@@ -100,82 +100,103 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    x              - Solution vector.
          *    f              - Right-hand side.
          *    b              - Condensed right-hand side.
-         *    r              - First residual. */
+         *    r              - First residual.
+         *    mu             - Number of right-hand sides (optional), see <Schur::allocateBlock>. Solution vectors and right-hand sides are stored with a leading dimension equal to the size of <Subdomain::a>. */
         template<bool excluded>
-        inline void start(K* const x, const K* const f, K* const b, K* r) const {
+        inline void start(K* const x, const K* const f, K* const b, K* r, const unsigned short& mu = 1) const {
+            const int n = mu;
             if(super::_co) {
                 if(!excluded) {
-                    super::condensateEffort(f, b);
-                    Subdomain<K>::exchange(b ? b : super::_structure + super::_bi->_m);
+                    const int ld = b ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                    K* const c = b ? b : super::_structure + super::_bi->_m;
+                    super::condensateEffort(f, b, mu);
+                    Subdomain<K>::exchange(c, mu, ld, super::getBuffer(mu));
                     if(super::_ev) {
-                        std::copy_n(b ? b : super::_structure + super::_bi->_m, Subdomain<K>::_dof, x);
-                        Wrapper<K>::diagv(Subdomain<K>::_dof, _m, x);
-                        if(super::_schur) {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), x, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), x, &i__1);
+                        for(unsigned short k = 0; k < mu; ++k)
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _m, c + k * ld, x + k * Subdomain<K>::_a->_n);
+                        if(super::_schur || super::_hodlr || super::_lowRank) {
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), x, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &n, &(Wrapper<K>::d__0), x, &(Subdomain<K>::_a->_n));
                         }
                         else {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), x, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), x, &i__1);
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), x, &(Subdomain<K>::_a->_n), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &n, &(Wrapper<K>::d__0), x, &(Subdomain<K>::_a->_n));
                         }
-                        Wrapper<K>::diagv(Subdomain<K>::_dof, _m, x);
+                        for(unsigned short k = 0; k < mu; ++k)
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _m, x + k * Subdomain<K>::_a->_n);
                     }
                     else {
-                        std::fill(x, x + Subdomain<K>::_dof, 0.0);
-                        super::_co->template callSolver<excluded>(super::_uc);
+                        for(unsigned short k = 0; k < mu; ++k)
+                            std::fill_n(x + k * Subdomain<K>::_a->_n, Subdomain<K>::_dof, 0.0);
+                        super::_co->template callSolver<excluded>(super::_uc, 0, mu);
                     }
-                    Subdomain<K>::exchange(x);
-                    super::applyLocalSchurComplement(x, r);
-                    Subdomain<K>::exchange(r);
-                    Wrapper<K>::axpby(Subdomain<K>::_dof, 1.0, b ? b : super::_structure + super::_bi->_m, 1, -1.0, r, 1);
+                    Subdomain<K>::exchange(x, mu, Subdomain<K>::_a->_n, super::getBuffer(mu));
+                    if(mu == 1)
+                        super::template applyLocalSchurComplement<true>(x, r);
+                    else {
+                        Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, x, &(Subdomain<K>::_a->_n), r, &(Subdomain<K>::_dof));
+                        super::template applyLocalSchurComplement<true>(r, mu, super::getBuffer(mu) + 2 * mu * super::_mult);
+                    }
+                    Subdomain<K>::exchange(r, mu, Subdomain<K>::_dof, super::getBuffer(mu));
+                    for(unsigned short k = 0; k < mu; ++k)
+                        Wrapper<K>::axpby(Subdomain<K>::_dof, 1.0, c + k * ld, 1, -1.0, r + k * Subdomain<K>::_dof, 1);
                 }
                 else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                    super::_co->template callSolver<excluded>(super::_uc, 0, mu);
             }
             else if(!excluded) {
-                super::condensateEffort(f, r);
-                Subdomain<K>::exchange(r);
-                std::fill(x, x + Subdomain<K>::_dof, 0.0);
+                super::condensateEffort(f, r, mu);
+                Subdomain<K>::exchange(r, mu, Subdomain<K>::_dof, super::getBuffer(mu));
+                for(unsigned short k = 0; k < mu; ++k)
+                    std::fill_n(x + k * Subdomain<K>::_a->_n, Subdomain<K>::_dof, 0.0);
             }
         }
         /* Function: apply
          *
-         *  Applies the global Schur complement to a single right-hand side.
+         *  Applies the global Schur complement to a single right-hand side, or to multiple right-hand sides.
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        inline void apply(K* const in, K* const out = nullptr) const {
-            if(out) {
-                super::applyLocalSchurComplement(in, out);
-                Subdomain<K>::exchange(out);
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Schur::allocateBlock>. */
+        inline void apply(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            if(mu == 1) {
+                if(out) {
+                    super::template applyLocalSchurComplement<true>(in, out);
+                    Subdomain<K>::exchange(out);
+                }
+                else {
+                    super::template applyLocalSchurComplement<true>(in);
+                    Subdomain<K>::exchange(in);
+                }
             }
             else {
-                super::applyLocalSchurComplement(in);
-                Subdomain<K>::exchange(in);
+                if(out)
+                    std::copy_n(in, mu * Subdomain<K>::_dof, out);
+                super::template applyLocalSchurComplement<true>(out ? out : in, mu, super::getBuffer(mu) + 2 * mu * super::_mult);
+                Subdomain<K>::exchange(out ? out : in, mu, Subdomain<K>::_dof, super::getBuffer(mu));
             }
         }
         /* Function: precond
          *
-         *  Applies the global preconditioner to a single right-hand side.
+         *  Applies the global preconditioner to a single right-hand side, or to multiple right-hand sides.
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        inline void precond(K* const in, K* const out = nullptr) const {
-            Wrapper<K>::diagv(Subdomain<K>::_dof, _m, in, super::_work + super::_bi->_m);
-            std::fill_n(super::_work, super::_bi->_m, 0.0);
-            super::_p.solve(super::_work);
-            if(out) {
-                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, super::_work + super::_bi->_m, out);
-                Subdomain<K>::exchange(out);
-            }
-            else {
-                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, super::_work + super::_bi->_m, in);
-                Subdomain<K>::exchange(in);
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Schur::allocateBlock>. */
+        inline void precond(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            K* const work = mu == 1 ? super::_work : super::_structure;
+            for(unsigned short k = 0; k < mu; ++k) {
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, in + k * Subdomain<K>::_dof, work + k * Subdomain<K>::_a->_n + super::_bi->_m);
+                std::fill_n(work + k * Subdomain<K>::_a->_n, super::_bi->_m, 0.0);
             }
+            super::_p.solve(work, mu);
+            for(unsigned short k = 0; k < mu; ++k)
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, work + k * Subdomain<K>::_a->_n + super::_bi->_m, (out ? out : in) + k * Subdomain<K>::_dof);
+            Subdomain<K>::exchange(out ? out : in, mu, Subdomain<K>::_dof, super::getBuffer(mu));
         }
         /* Function: project
          *
@@ -187,49 +208,61 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Schur::allocateBlock>. */
         template<bool excluded, char trans>
-        inline void project(K* const in, K* const out = nullptr) const {
+        inline void project(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
             if(super::_co) {
                 if(!excluded) {
+                    const int n = mu;
+                    K* const tmp = mu == 1 ? super::_structure + super::_bi->_m : super::_structure + mu * Subdomain<K>::_a->_n;
                     if(trans == 'N')
-                        apply(in, super::_structure + super::_bi->_m);
+                        apply(in, tmp, mu);
                     if(super::_ev) {
-                        if(trans == 'N')
-                            Wrapper<K>::diagv(Subdomain<K>::_dof, _m, super::_structure + super::_bi->_m);
-                        else
-                            Wrapper<K>::diagv(Subdomain<K>::_dof, _m, in, super::_structure + super::_bi->_m);
-                        if(super::_schur) {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_structure + super::_bi->_m, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), super::_structure + super::_bi->_m, &i__1);
+                        for(unsigned short k = 0; k < mu; ++k) {
+                            if(trans == 'N')
+                                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, tmp + k * Subdomain<K>::_dof);
+                            else
+                                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, in + k * Subdomain<K>::_dof, tmp + k * Subdomain<K>::_dof);
+                        }
+                        if(super::_evc) {
+                            super::template applyVectors<'T'>(tmp, super::_uc, mu, Subdomain<K>::_dof);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            super::template applyVectors<'N'>(super::_uc, tmp, mu, Subdomain<K>::_dof);
+                        }
+                        else if(super::_schur || super::_hodlr || super::_lowRank) {
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), tmp, &(Subdomain<K>::_dof), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &n, &(Wrapper<K>::d__0), tmp, &(Subdomain<K>::_dof));
                         }
                         else {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_structure + super::_bi->_m, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->callSolver(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), super::_structure + super::_bi->_m, &i__1);
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), tmp, &(Subdomain<K>::_dof), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->callSolver(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &n, &(Wrapper<K>::d__0), tmp, &(Subdomain<K>::_dof));
                         }
                     }
                     else {
-                        super::_co->callSolver(super::_uc);
-                        std::fill_n(super::_structure + super::_bi->_m, Subdomain<K>::_dof, 0.0);
+                        super::_co->callSolver(super::_uc, 0, mu);
+                        std::fill_n(tmp, mu * Subdomain<K>::_dof, 0.0);
                     }
-                    Wrapper<K>::diagv(Subdomain<K>::_dof, _m, super::_structure + super::_bi->_m);
-                    Subdomain<K>::exchange(super::_structure + super::_bi->_m);
+                    for(unsigned short k = 0; k < mu; ++k)
+                        Wrapper<K>::diagv(Subdomain<K>::_dof, _m, tmp + k * Subdomain<K>::_dof);
+                    Subdomain<K>::exchange(tmp, mu, Subdomain<K>::_dof, super::getBuffer(mu));
                     if(trans == 'T')
-                        apply(super::_structure + super::_bi->_m);
+                        apply(tmp, nullptr, mu);
+                    const int size = mu * Subdomain<K>::_dof;
                     if(out)
-                        for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i)
-                            out[i] = in[i] - *(super::_structure + super::_bi->_m + i);
+                        for(int i = 0; i < size; ++i)
+                            out[i] = in[i] - tmp[i];
                     else
-                        Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), super::_structure + super::_bi->_m, &i__1, in, &i__1);
+                        Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), tmp, &i__1, in, &i__1);
                 }
                 else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                    super::_co->template callSolver<excluded>(super::_uc, 0, mu);
             }
             else if(!excluded && out)
-                std::copy(in, in + Subdomain<K>::_dof, out);
+                std::copy_n(in, mu * Subdomain<K>::_dof, out);
         }
         /* Function: buildTwo
          *
@@ -246,7 +279,7 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         template<unsigned short excluded = 0, class Container>
         inline std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm, Container& parm) {
             BddProjection<Bdd<Solver, CoarseSolver, S, K>, K> s(*this, parm[NU]);
-            if(!super::_schur && parm[NU])
+            if(!super::_schur && !super::_hodlr && !super::_lowRank && parm[NU])
                 super::_deficiency = parm[NU];
             return super::template buildTwo<excluded, 3>(s, comm, parm);
         }
@@ -259,23 +292,38 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    x              - Solution vector.
-         *    f              - Right-hand side. */
+         *    f              - Right-hand side.
+         *    mu             - Number of right-hand sides (optional), see <Bdd::start>. */
         template<bool excluded>
-        inline void computeSolution(K* const x, const K* const f) const {
+        inline void computeSolution(K* const x, const K* const f, const unsigned short& mu = 1) const {
             if(!excluded) {
-                std::copy(f, f + super::_bi->_m, x);
-                Wrapper<K>::template csrmv<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, x + super::_bi->_m, &(Wrapper<K>::d__1), x);
-                if(!super::_schur)
-                    super::_s.solve(x);
+                if(mu == 1) {
+                    std::copy(f, f + super::_bi->_m, x);
+                    Wrapper<K>::template csrmv<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, x + super::_bi->_m, &(Wrapper<K>::d__1), x);
+                    if(!super::_schur && !super::_hodlr)
+                        super::_s.solve(x);
+                    else {
+                        std::copy(x, x + super::_bi->_m, super::_structure);
+                        super::_s.solve(super::_structure);
+                        std::copy(super::_structure, super::_structure + super::_bi->_m, x);
+                    }
+                }
                 else {
-                    std::copy(x, x + super::_bi->_m, super::_structure);
-                    super::_s.solve(super::_structure);
-                    std::copy(super::_structure, super::_structure + super::_bi->_m, x);
+                    const int n = mu;
+                    K* const primal = super::_structure + mu * Subdomain<K>::_a->_n;
+                    K* const work = super::getBuffer(mu) + 2 * mu * super::_mult;
+                    for(unsigned short k = 0; k < mu; ++k)
+                        std::copy_n(f + k * Subdomain<K>::_a->_n, super::_bi->_m, work + k * super::_bi->_m);
+                    Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, x + super::_bi->_m, &(Subdomain<K>::_a->_n), primal, &(Subdomain<K>::_dof));
+                    Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &n, &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, primal, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &(super::_bi->_m));
+                    super::_s.solve(work, mu);
+                    for(unsigned short k = 0; k < mu; ++k)
+                        std::copy_n(work + k * super::_bi->_m, super::_bi->_m, x + k * Subdomain<K>::_a->_n);
                 }
             }
         }
         template<bool excluded>
-        inline void computeSolution(K* const x, K* const* const l) const { }
+        inline void computeSolution(K* const, K* const* const, const unsigned short& = 1) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two vectors.
@@ -285,16 +333,18 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    mu             - Number of vectors (optional), in which case mu dot products are computed. */
         template<bool excluded>
-        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const a, const K* const b, const MPI_Comm& comm) const {
-            if(!excluded) {
-                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, a, super::_work);
-                *val = Wrapper<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b, &i__1);
-            }
+        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const a, const K* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
+            if(!excluded)
+                for(unsigned short k = 0; k < mu; ++k) {
+                    Wrapper<K>::diagv(Subdomain<K>::_dof, _m, a + k * Subdomain<K>::_dof, super::_work);
+                    val[k] = Wrapper<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b + k * Subdomain<K>::_dof, &i__1);
+                }
             else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                std::fill_n(val, mu, 0.0);
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Bdd::m>. */
@@ -0,0 +1,438 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <jolivet@ann.jussieu.fr>
+        Date: 2015-03-02
+
+   Copyright (C) 2011-2014 Université de Grenoble
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BDDC_
+#define _BDDC_
+
+#include <map>
+#include "BDD.hpp"
+
+namespace HPDDM {
+/* Class: Bddc
+ *
+ *  A class for solving problems using the BDDC method. The global Schur complement is the same as in <Bdd>, but instead of projecting onto a coarse space, it is preconditioned by the sum of a coarse correction and of local corrections subject to primal constraints: continuity at the corners, i.e., the interface degrees of freedom shared by at least three subdomains, and continuity of the averages over the edges, i.e., the sets of interface degrees of freedom shared by the same two subdomains. The local problems are saddle-point problems bordered by the edge averages, and are thus nonsingular even for floating subdomains without corners, and the coarse operator is assembled by <Coarse operator> from local contributions of the size of the number of local primal constraints.
+ *
+ * Template Parameters:
+ *    Solver         - Solver used for the factorization of local matrices.
+ *    CoarseOperator - Class of the coarse operator.
+ *    S              - 'S'ymmetric or 'G'eneral coarse operator.
+ *    K              - Scalar type. */
+template<template<class> class Solver, template<class> class CoarseSolver, char S, class K>
+class Bddc : public Bdd<Solver, CoarseSolver, S, K> {
+    private:
+        /* Variable: rr
+         *  Local matrix assembled on all degrees of freedom but corners, bordered by the edge averages. */
+        MatrixCSR<K>*                               _rr;
+        /* Variable: corners
+         *  Interface degrees of freedom on which continuity is enforced. */
+        std::vector<int>                       _corners;
+        /* Variable: remainder
+         *  Interface degrees of freedom that are not corners. */
+        std::vector<int>                     _remainder;
+        /* Variable: averages
+         *  Edges, stored as indices in <Bddc::remainder>, over which continuity of the averages is enforced. */
+        std::vector<std::vector<int>>         _averages;
+        /* Variable: owners
+         *  Ranks of the processes owning the local primal constraints, corners first, and indices of the constraints among those owned by these processes. */
+        std::vector<std::pair<int, unsigned int>> _owners;
+        /* Variable: shared
+         *  Local primal constraints owned by the process or by each neighboring subdomain, in the order of first appearance in <Subdomain::map>. */
+        std::vector<std::vector<int>>           _shared;
+        /* Variable: phi
+         *  Restriction to the interface of the local coarse basis functions. */
+        K*                                         _phi;
+        /* Variable: primal
+         *  Workspace for local primal vectors, followed by workspaces for the local problems and for exchanging primal values. */
+        K*                                      _primal;
+        /* Function: selectPrimal
+         *
+         *  Splits the interface into corners and edges, one set of each per component, and numbers the primal constraints. Each primal constraint is owned by the subdomain of lowest rank sharing it, which sends its index among the owned constraints to its neighbors in the order of first appearance in <Subdomain::map>.
+         *
+         * Parameter:
+         *    components     - Number of unknowns per node, the unknowns of each interface node being numbered contiguously. */
+        inline void selectPrimal(const unsigned short& components) {
+            int rank;
+            MPI_Comm_rank(Subdomain<K>::_communicator, &rank);
+            std::vector<std::vector<int>> sharing(Subdomain<K>::_dof);
+            for(const pairNeighbor& neighbor : Subdomain<K>::_map)
+                for(pairNeighbor::second_type::const_reference p : neighbor.second)
+                    sharing[p].emplace_back(neighbor.first);
+            std::map<std::pair<std::vector<int>, unsigned short>, std::vector<int>> classes;
+            for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                if(!sharing[i].empty()) {
+                    std::sort(sharing[i].begin(), sharing[i].end());
+                    classes[std::make_pair(sharing[i], i % components)].emplace_back(i);
+                }
+            std::vector<int> primal(Subdomain<K>::_dof, -1);
+            unsigned int owned = 0;
+            _corners.clear();
+            _remainder.clear();
+            _averages.clear();
+            _owners.clear();
+            for(decltype(classes)::const_reference c : classes)
+                if(c.first.first.size() > 1 || c.second.size() == 1)
+                    for(const int& i : c.second) {
+                        primal[i] = _corners.size();
+                        _corners.emplace_back(i);
+                        const int owner = std::min(rank, c.first.first.front());
+                        _owners.emplace_back(owner, owner == rank ? owned++ : 0);
+                    }
+            std::vector<int> position(Subdomain<K>::_dof);
+            for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                if(primal[i] == -1) {
+                    position[i] = _remainder.size();
+                    _remainder.emplace_back(i);
+                }
+            for(decltype(classes)::const_reference c : classes)
+                if(c.first.first.size() == 1 && c.second.size() > 1) {
+                    _averages.emplace_back();
+                    _averages.back().reserve(c.second.size());
+                    for(const int& i : c.second) {
+                        primal[i] = _owners.size();
+                        _averages.back().emplace_back(position[i]);
+                    }
+                    const int owner = std::min(rank, c.first.first.front());
+                    _owners.emplace_back(owner, owner == rank ? owned++ : 0);
+                }
+            _shared.assign(Subdomain<K>::_map.size(), std::vector<int>());
+            std::vector<std::vector<unsigned int>> send(Subdomain<K>::_map.size()), recv(Subdomain<K>::_map.size());
+            std::vector<int> stamp(_owners.size(), -1);
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                for(pairNeighbor::second_type::const_reference p : Subdomain<K>::_map[i].second) {
+                    const int j = primal[p];
+                    if(j != -1 && stamp[j] != i) {
+                        stamp[j] = i;
+                        if(_owners[j].first == rank) {
+                            send[i].emplace_back(_owners[j].second);
+                            _shared[i].emplace_back(j);
+                        }
+                        else if(_owners[j].first == Subdomain<K>::_map[i].first)
+                            _shared[i].emplace_back(j);
+                    }
+                }
+                recv[i].resize(_shared[i].size() - send[i].size());
+                if(!recv[i].empty())
+                    MPI_Irecv(recv[i].data(), recv[i].size(), MPI_UNSIGNED, Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
+                else
+                    Subdomain<K>::_rq[i] = MPI_REQUEST_NULL;
+                if(!send[i].empty())
+                    MPI_Isend(send[i].data(), send[i].size(), MPI_UNSIGNED, Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                else
+                    Subdomain<K>::_rq[Subdomain<K>::_map.size() + i] = MPI_REQUEST_NULL;
+            }
+            MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                std::vector<unsigned int>::const_iterator it = recv[i].cbegin();
+                for(const int& j : _shared[i])
+                    if(_owners[j].first != rank)
+                        _owners[j].second = *it++;
+            }
+        }
+        /* Function: allocatePrimal
+         *
+         *  Reallocates <Bddc::primal>.
+         *
+         * Parameter:
+         *    mu             - Number of vectors. */
+        inline void allocatePrimal(const unsigned short& mu) {
+            unsigned int shared = 0;
+            for(const std::vector<int>& v : _shared)
+                shared += v.size();
+            delete [] _primal;
+            _primal = new K[mu * (_owners.size() + _rr->_n + 2 * shared)];
+        }
+        /* Function: exchangePrimal
+         *
+         *  Sums the local primal vectors in <Bddc::primal> into the right-hand sides of the coarse problem, or scatters the solutions of the coarse problem to the local primal vectors.
+         *
+         * Template Parameter:
+         *    scatter        - True if the solutions are scattered, false if the local primal vectors are summed.
+         *
+         * Parameter:
+         *    mu             - Number of vectors. */
+        template<bool scatter>
+        inline void exchangePrimal(const unsigned short& mu) const {
+            const int rank = super::getRank();
+            unsigned int shared = 0;
+            for(const std::vector<int>& v : _shared)
+                shared += v.size();
+            K* const send = _primal + mu * (_owners.size() + _rr->_n);
+            K* const recv = send + mu * shared;
+            if(!scatter)
+                std::fill_n(super::_uc, mu * super::_co->getLocal(), K());
+            unsigned int offset = 0;
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); offset += mu * _shared[i++].size()) {
+                // the owner sends the solutions of the constraints it owns, the other process sends its local contributions
+                const int source = scatter ? Subdomain<K>::_map[i].first : rank;
+                unsigned int size = 0;
+                for(const int& j : _shared[i])
+                    if(_owners[j].first == source)
+                        ++size;
+                if(size)
+                    MPI_Irecv(recv + offset, mu * size, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
+                else
+                    Subdomain<K>::_rq[i] = MPI_REQUEST_NULL;
+                size = 0;
+                for(const int& j : _shared[i])
+                    if(_owners[j].first != source) {
+                        if(scatter)
+                            std::copy_n(super::_uc + _owners[j].second * mu, mu, send + offset + mu * size++);
+                        else
+                            std::copy_n(_primal + j * mu, mu, send + offset + mu * size++);
+                    }
+                if(size)
+                    MPI_Isend(send + offset, mu * size, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                else
+                    Subdomain<K>::_rq[Subdomain<K>::_map.size() + i] = MPI_REQUEST_NULL;
+            }
+            for(unsigned int j = 0; j < _owners.size(); ++j)
+                if(_owners[j].first == rank) {
+                    if(scatter)
+                        std::copy_n(super::_uc + _owners[j].second * mu, mu, _primal + j * mu);
+                    else
+                        for(unsigned short k = 0; k < mu; ++k)
+                            super::_uc[_owners[j].second * mu + k] += _primal[j * mu + k];
+                }
+            MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+            offset = 0;
+            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); offset += mu * _shared[i++].size()) {
+                const int source = scatter ? Subdomain<K>::_map[i].first : rank;
+                unsigned int size = 0;
+                for(const int& j : _shared[i])
+                    if(_owners[j].first == source) {
+                        if(scatter)
+                            std::copy_n(recv + offset + mu * size, mu, _primal + j * mu);
+                        else
+                            for(unsigned short k = 0; k < mu; ++k)
+                                super::_uc[_owners[j].second * mu + k] += recv[offset + mu * size + k];
+                        ++size;
+                    }
+            }
+        }
+    public:
+        Bddc() : _rr(), _phi(), _primal() { }
+        ~Bddc() {
+            delete       _rr;
+            delete []   _phi;
+            delete [] _primal;
+        }
+        /* Typedef: super
+         *  Type of the immediate parent class <Bdd>. */
+        typedef Bdd<Solver, CoarseSolver, S, K> super;
+        /* Function: allocateBlock
+         *  Calls <Schur::allocateBlock> and reallocates <Bddc::primal> so that it can hold multiple vectors. */
+        inline void allocateBlock(const unsigned short& mu) {
+            super::allocateBlock(mu);
+            if(_rr)
+                allocatePrimal(mu);
+        }
+        /* Function: callNumfact
+         *
+         *  Selects the primal constraints by calling <Bddc::selectPrimal>, and factorizes <Subdomain::a> restricted to all degrees of freedom but corners and bordered by the edge averages. This replaces <Schur::callNumfact> and must be called after <Schur::renumber>.
+         *
+         * Parameter:
+         *    components     - Number of unknowns per node (optional), see <Bddc::selectPrimal>. */
+        inline void callNumfact(const unsigned short& components = 1) {
+            if(Subdomain<K>::_a) {
+                selectPrimal(components);
+                const int m = super::_bi->_m;
+                const int n = m + _remainder.size();
+                std::vector<int> position(Subdomain<K>::_a->_n, -1);
+                std::iota(position.begin(), position.begin() + m, 0);
+                for(unsigned int i = 0; i < _remainder.size(); ++i)
+                    position[m + _remainder[i]] = m + i;
+                int nnz = 0;
+                for(int i = 0; i < Subdomain<K>::_a->_n; ++i)
+                    if(position[i] != -1)
+                        for(int j = Subdomain<K>::_a->_ia[i]; j < Subdomain<K>::_a->_ia[i + 1]; ++j)
+                            if(position[Subdomain<K>::_a->_ja[j]] != -1)
+                                ++nnz;
+                for(const std::vector<int>& average : _averages)
+                    nnz += average.size() + 1;
+                delete _rr;
+                _rr = new MatrixCSR<K>(n + _averages.size(), n + _averages.size(), nnz, true);
+                _rr->_ia[0] = nnz = 0;
+                for(int i = 0, k = 0; i < Subdomain<K>::_a->_n; ++i)
+                    if(position[i] != -1) {
+                        for(int j = Subdomain<K>::_a->_ia[i]; j < Subdomain<K>::_a->_ia[i + 1]; ++j)
+                            if(position[Subdomain<K>::_a->_ja[j]] != -1) {
+                                _rr->_ja[nnz] = position[Subdomain<K>::_a->_ja[j]];
+                                _rr->_a[nnz++] = Subdomain<K>::_a->_a[j];
+                            }
+                        _rr->_ia[++k] = nnz;
+                    }
+                // each edge average is a Lagrange multiplier, whose row is stored after the remainder with an explicit zero on the diagonal
+                for(unsigned int i = 0; i < _averages.size(); ++i) {
+                    for(const int& p : _averages[i]) {
+                        _rr->_ja[nnz] = m + p;
+                        _rr->_a[nnz++] = Wrapper<K>::d__1 / static_cast<typename Wrapper<K>::ul_type>(_averages[i].size());
+                    }
+                    _rr->_ja[nnz] = n + i;
+                    _rr->_a[nnz++] = K();
+                    _rr->_ia[n + i + 1] = nnz;
+                }
+                super::_p.numfact(_rr, !_averages.empty());
+            }
+            else
+                std::cerr << "The matrix '_a' has not been allocated => impossible to build the local solvers" << std::endl;
+        }
+        /* Function: buildTwo
+         *
+         *  Computes the local coarse basis functions, and assembles and factorizes the coarse operator. This replaces <Bdd::buildTwo> and must be called after <Bddc::callNumfact> and <Schur::callNumfactPreconditioner>. The master processes must not be excluded from the domain decomposition, and the parameter NU is set to the number of primal constraints owned by the process.
+         *
+         * Parameters:
+         *    comm           - Global MPI communicator.
+         *    parm           - Vector of parameters. */
+        template<class Container>
+        inline std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm, Container& parm) {
+            const int m = super::_bi->_m;
+            const int n = m + _remainder.size();
+            const int c = _owners.size();
+            K* const work = new K[c * _rr->_n + 2 * Subdomain<K>::_a->_n];
+            K* const in = work + c * _rr->_n;
+            K* const out = in + Subdomain<K>::_a->_n;
+            std::fill_n(work, c * _rr->_n, K());
+            for(unsigned int i = 0; i < _corners.size(); ++i) {
+                std::fill_n(in, Subdomain<K>::_a->_n, K());
+                in[m + _corners[i]] = Wrapper<K>::d__2;
+                Wrapper<K>::template csrmv<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_a->_n), Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
+                std::copy_n(out, m, work + i * _rr->_n);
+                for(unsigned int j = 0; j < _remainder.size(); ++j)
+                    work[i * _rr->_n + m + j] = out[m + _remainder[j]];
+            }
+            for(unsigned int i = 0; i < _averages.size(); ++i)
+                work[(_corners.size() + i) * _rr->_n + n + i] = Wrapper<K>::d__1;
+            if(c)
+                super::_p.solve(work, c);
+            delete [] _phi;
+            _phi = new K[Subdomain<K>::_dof * c]();
+            for(int i = 0; i < c; ++i) {
+                K* const phi = _phi + i * Subdomain<K>::_dof;
+                for(unsigned int j = 0; j < _remainder.size(); ++j)
+                    phi[_remainder[j]] = work[i * _rr->_n + m + j];
+                if(i < static_cast<int>(_corners.size()))
+                    phi[_corners[i]] = Wrapper<K>::d__1;
+            }
+            delete [] work;
+            K* const local = new K[c * (Subdomain<K>::_dof + c) + super::getWorkspace(c)];
+            if(c) {
+                std::copy_n(_phi, c * Subdomain<K>::_dof, local + c * c);
+                super::template applyLocalSchurComplement<true>(local + c * c, c, local + c * (Subdomain<K>::_dof + c));
+                Wrapper<K>::gemm(&transb, &transa, &c, &c, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _phi, &(Subdomain<K>::_dof), local + c * c, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), local, &c);
+            }
+            const int rank = super::getRank();
+            parm[NU] = std::count_if(_owners.cbegin(), _owners.cend(), [&](const std::pair<int, unsigned int>& p) { return p.first == rank; });
+            BddcAssembly<Bddc<Solver, CoarseSolver, S, K>, K> s(*this, parm[NU], local);
+            std::pair<MPI_Request, const K*>* ret = super::super::template buildTwo<0, 3>(s, comm, parm);
+            delete [] local;
+            allocatePrimal(1);
+            return ret;
+        }
+        /* Function: start
+         *
+         *  Projected Conjugate Gradient initialization. The coarse correction is part of <Bddc::precond>, so that, unlike in <Bdd::start>, the initial guess is zero.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    x              - Solution vector.
+         *    f              - Right-hand side.
+         *    b              - Condensed right-hand side, not used.
+         *    r              - First residual.
+         *    mu             - Number of right-hand sides (optional), see <Schur::allocateBlock>. */
+        template<bool excluded>
+        inline void start(K* const x, const K* const f, K* const, K* r, const unsigned short& mu = 1) const {
+            if(!excluded) {
+                super::condensateEffort(f, r, mu);
+                Subdomain<K>::exchange(r, mu, Subdomain<K>::_dof, super::getBuffer(mu));
+                for(unsigned short k = 0; k < mu; ++k)
+                    std::fill_n(x + k * Subdomain<K>::_a->_n, Subdomain<K>::_dof, K());
+            }
+        }
+        /* Function: precond
+         *
+         *  Applies the global preconditioner to a single right-hand side, or to multiple right-hand sides.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Schur::allocateBlock>. */
+        inline void precond(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            const int m = super::_bi->_m;
+            const int n = mu;
+            const int c = _owners.size();
+            K* const z = out ? out : in;
+            K* const work = _primal + mu * c;
+            std::fill_n(work, mu * _rr->_n, K());
+            for(unsigned short k = 0; k < mu; ++k) {
+                Wrapper<K>::diagv(Subdomain<K>::_dof, super::getScaling(), in + k * Subdomain<K>::_dof, z + k * Subdomain<K>::_dof);
+                for(unsigned int i = 0; i < _remainder.size(); ++i)
+                    work[k * _rr->_n + m + i] = z[k * Subdomain<K>::_dof + _remainder[i]];
+            }
+            if(super::_co) {
+                Wrapper<K>::gemm(&transb, &transa, &n, &c, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), z, &(Subdomain<K>::_dof), _phi, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), _primal, &n);
+                exchangePrimal<false>(mu);
+                super::_co->callSolver(super::_uc, 0, mu);
+                exchangePrimal<true>(mu);
+                Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, &c, &(Wrapper<K>::d__1), _phi, &(Subdomain<K>::_dof), _primal, &n, &(Wrapper<K>::d__0), z, &(Subdomain<K>::_dof));
+            }
+            else
+                std::fill_n(z, mu * Subdomain<K>::_dof, K());
+            super::_p.solve(work, mu);
+            for(unsigned short k = 0; k < mu; ++k) {
+                for(unsigned int i = 0; i < _remainder.size(); ++i)
+                    z[k * Subdomain<K>::_dof + _remainder[i]] += work[k * _rr->_n + m + i];
+                Wrapper<K>::diagv(Subdomain<K>::_dof, super::getScaling(), z + k * Subdomain<K>::_dof);
+            }
+            Subdomain<K>::exchange(z, mu, Subdomain<K>::_dof, super::getBuffer(mu));
+        }
+        /* Function: project
+         *
+         *  Copies the input vector, since the coarse correction is part of <Bddc::precond> and no projection is needed.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    trans          - 'T' if the transposed projection should be applied, 'N' otherwise.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Schur::allocateBlock>. */
+        template<bool excluded, char trans>
+        inline void project(K* const in, K* const out = nullptr, const unsigned short& mu = 1) const {
+            static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(!excluded && out)
+                std::copy_n(in, mu * Subdomain<K>::_dof, out);
+        }
+        /* Function: getOwners
+         *  Returns a constant reference to <Bddc::owners>. */
+        inline const std::vector<std::pair<int, unsigned int>>& getOwners() const { return _owners; }
+        /* Function: getShared
+         *  Returns a constant reference to <Bddc::shared>. */
+        inline const std::vector<std::vector<int>>& getShared() const { return _shared; }
+        /* Function: getPrimal
+         *  Returns the number of local primal constraints. */
+        inline int getPrimal() const { return _owners.size(); }
+};
+} // HPDDM
+#endif // _BDDC_
@@ -47,44 +47,94 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         /* Variable: m
          *  Local partition of unity. */
         typename Wrapper<K>::ul_type** _m;
+        /* Variable: jump
+         *  Signed Boolean jump operator, stored as an array mapping local dual unknowns to primal unknowns, followed by the row pointers and the column indices of its transpose in Compressed Sparse Row format, see <Feti::initialize>. */
+        int*                        _jump;
+        /* Variable: split
+         *  Number of local dual unknowns shared with neighboring subdomains of lower ranks, i.e. with a negative sign in <Feti::jump>. */
+        int                        _split;
+        /* Function: post
+         *
+         *  Posts the receives of the dual unknowns of neighboring subdomains needed by <Feti::A>, so that they can be matched while local computations are performed.
+         *
+         * Parameter:
+         *    mu             - Number of vectors (optional). */
+        inline void post(const unsigned short& mu = 1) const {
+            if(mu == 1)
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                    MPI_Irecv(Subdomain<K>::_rbuff[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
+            else {
+                K* const recv = super::getBuffer(mu) + mu * super::_mult;
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                    MPI_Irecv(recv + mu * (_dual[i] - *_dual), mu * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
+            }
+        }
         /* Function: A
          *
-         *  Jump operator.
+         *  Jump operator. With multiple vectors, primal unknowns are stored with a leading dimension equal to the size of <Subdomain::a>, and values are exchanged using a single message per neighboring subdomain.
          *
          * Template Parameters:
          *    trans          - 'T' if the transposed jump operator should be applied, 'N' otherwise.
          *    scale          - True if the unknowns should be scale by <Feti::m>, false otherwise.
+         *    posted         - True if the receives have already been posted by <Feti::post>, false otherwise.
          *
          * Parameters:
          *    primal         - Primal unknowns.
-         *    dual           - Dual unknowns. */
-        template<char trans, bool scale>
-        inline void A(K* const primal, K* const* const dual) const {
+         *    dual           - Dual unknowns.
+         *    mu             - Number of vectors (optional). */
+        template<char trans, bool scale, bool posted = false>
+        inline void A(K* const primal, K* const* const dual, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            const typename Wrapper<K>::ul_type* const m = *_m;
             if(trans == 'T') {
-                std::fill(primal, primal + Subdomain<K>::_dof, 0.0);
-                for(unsigned short i = 0; i < super::_signed; ++i)
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        primal[Subdomain<K>::_map[i].second[j]] -= scale ? _m[i][j] * dual[i][j] : dual[i][j];
-                for(unsigned short i = super::_signed; i < Subdomain<K>::_map.size(); ++i)
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        primal[Subdomain<K>::_map[i].second[j]] += scale ? _m[i][j] * dual[i][j] : dual[i][j];
+                const int* const ia = _jump + super::_mult;
+                const int* const ja = ia + Subdomain<K>::_dof + 1;
+                for(unsigned short k = 0; k < mu; ++k) {
+                    const K* const pt = *dual + k * super::_mult;
+                    K* const out = primal + k * Subdomain<K>::_a->_n;
+                    for(int i = 0; i < Subdomain<K>::_dof; ++i) {
+                        K sum = K();
+                        for(int j = ia[i]; j < ia[i + 1]; ++j) {
+                            const K val = scale ? m[ja[j]] * pt[ja[j]] : pt[ja[j]];
+                            sum += ja[j] < _split ? -val : val;
+                        }
+                        out[i] = sum;
+                    }
+                }
             }
             else {
-                for(unsigned short i = 0; i < super::_signed; ++i) {
-                    MPI_Irecv(Subdomain<K>::_rbuff[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        dual[i][j] = -(scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
-                    MPI_Isend(dual[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                if(!posted)
+                    post(mu);
+                for(unsigned short k = 0; k < mu; ++k) {
+                    K* const pt = *dual + k * super::_mult;
+                    const K* const in = primal + k * Subdomain<K>::_a->_n;
+                    for(int i = 0; i < _split; ++i)
+                        pt[i] = -(scale ? m[i] * in[_jump[i]] : in[_jump[i]]);
+                    for(int i = _split; i < super::_mult; ++i)
+                        pt[i] =  (scale ? m[i] * in[_jump[i]] : in[_jump[i]]);
                 }
-                for(unsigned short i = super::_signed; i < Subdomain<K>::_map.size(); ++i) {
-                    MPI_Irecv(Subdomain<K>::_rbuff[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
-                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        dual[i][j] =  (scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
-                    MPI_Isend(dual[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                if(mu == 1) {
+                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
+                        MPI_Isend(dual[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                    MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+                    Wrapper<K>::axpy(&(super::_mult), &(Wrapper<K>::d__1), Subdomain<K>::_rbuff[0], &i__1, *dual, &i__1);
+                }
+                else {
+                    K* const send = super::getBuffer(mu);
+                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                        const int offset = dual[i] - *dual;
+                        for(unsigned short k = 0; k < mu; ++k)
+                            std::copy_n(dual[i] + k * super::_mult, Subdomain<K>::_map[i].second.size(), send + mu * offset + k * Subdomain<K>::_map[i].second.size());
+                        MPI_Isend(send + mu * offset, mu * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                    }
+                    MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                        const int offset = dual[i] - *dual;
+                        const int n = Subdomain<K>::_map[i].second.size();
+                        for(unsigned short k = 0; k < mu; ++k)
+                            Wrapper<K>::axpy(&n, &(Wrapper<K>::d__1), send + mu * (super::_mult + offset) + k * n, &i__1, dual[i] + k * super::_mult, &i__1);
+                    }
                 }
-                MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
-                Wrapper<K>::axpy(&(super::_mult), &(Wrapper<K>::d__1), Subdomain<K>::_rbuff[0], &i__1, *dual, &i__1);
             }
         }
         template<class U, typename std::enable_if<std::is_same<U, typename Wrapper<U>::ul_type>::value>::type* = nullptr>
@@ -100,8 +150,9 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             m    = new typename Wrapper<U>::ul_type*[Subdomain<K>::_map.size()];
         }
     public:
-        Feti() : _primal(), _dual(), _m() { }
+        Feti() : _primal(), _dual(), _m(), _jump(), _split() { }
         ~Feti() {
+            delete [] _jump;
             if(_m)
                 delete [] *_m;
             if(!std::is_same<K, typename Wrapper<K>::ul_type>::value)
@@ -112,7 +163,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *  Type of the immediate parent class <Schur>. */
         typedef Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> super;
         /* Function: initialize
-         *  Allocates <Feti::primal>, <Feti::dual>, and <Feti::m> and calls <Schur::initialize>. */
+         *  Allocates <Feti::primal>, <Feti::dual>, and <Feti::m>, calls <Schur::initialize>, and assembles <Feti::jump>. */
         inline void initialize() {
             super::template initialize<true>();
             _primal = super::_structure + super::_bi->_m;
@@ -123,6 +174,37 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                 _dual[i] = _dual[i - 1] + Subdomain<K>::_map[i - 1].second.size();
                 _m   [i] = _m[i - 1]    + Subdomain<K>::_map[i - 1].second.size();
             }
+            delete [] _jump;
+            _jump = new int[2 * super::_mult + Subdomain<K>::_dof + 1];
+            int* const ia = _jump + super::_mult;
+            int* const ja = ia + Subdomain<K>::_dof + 1;
+            std::fill_n(ia, Subdomain<K>::_dof + 1, 0);
+            _split = 0;
+            for(unsigned short i = 0, k = 0; i < Subdomain<K>::_map.size(); ++i) {
+                for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j, ++k) {
+                    _jump[k] = Subdomain<K>::_map[i].second[j];
+                    ++ia[_jump[k] + 1];
+                }
+                if(i < super::_signed)
+                    _split = k;
+            }
+            std::partial_sum(ia, ia + Subdomain<K>::_dof + 1, ia);
+            for(int k = 0; k < super::_mult; ++k)
+                ja[ia[_jump[k]]++] = k;
+            for(unsigned int i = Subdomain<K>::_dof; i > 0; --i)
+                ia[i] = ia[i - 1];
+            ia[0] = 0;
+        }
+        /* Function: allocateBlock
+         *  Calls <Schur::allocateBlock>, and updates <Feti::primal> and <Feti::dual> accordingly. */
+        inline void allocateBlock(const unsigned short& mu) {
+            super::allocateBlock(mu);
+            if(super::_work) {
+                _primal = super::_structure + super::_bi->_m;
+                *_dual = super::_work;
+                for(unsigned short i = 1; i < Subdomain<K>::_map.size(); ++i)
+                    _dual[i] = _dual[i - 1] + Subdomain<K>::_map[i - 1].second.size();
+            }
         }
         /* Function: start
          *
@@ -135,61 +217,68 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    x              - Solution vector.
          *    f              - Right-hand side.
          *    b              - Condensed right-hand side.
-         *    r              - First residual. */
+         *    r              - First residual.
+         *    mu             - Number of right-hand sides (optional), see <Feti::allocateBlock>. */
         template<bool excluded>
-        inline void start(K* const x, const K* const f, K* const* const l, K* const* const r) const {
+        inline void start(K* const x, const K* const f, K* const* const l, K* const* const r, const unsigned short& mu = 1) const {
+            const int n = mu;
             if(super::_co) {
                 if(!excluded) {
                     if(super::_ev) {
-                        if(super::_schur) {
-                            super::condensateEffort(f, nullptr);
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_structure + super::_bi->_m, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1); //     _uc = R_b g
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                                    //     _uc = (G Q G^T) \ R_b g
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                            // _primal = R_b (G Q G^T) \ R f
+                        if(super::_schur || super::_hodlr || super::_lowRank) {
+                            super::condensateEffort(f, nullptr, mu);
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), super::_structure + super::_bi->_m, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, &n); //     _uc = R_b g
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);                                                                                                                                                                              //     _uc = (G Q G^T) \ R_b g
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &n, &(Wrapper<K>::d__0), _primal, &(Subdomain<K>::_a->_n));            // _primal = R_b (G Q G^T) \ R f
                         }
                         else {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_a->_n), f, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);                              //     _uc = R f
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                                    //     _uc = (G Q G^T) \ R f
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);         // _primal = R_b (G Q G^T) \ R f
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__1), f, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), super::_uc, &n);                  //     _uc = R f
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);                                                                                                                                                                              //     _uc = (G Q G^T) \ R f
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &n, &(Wrapper<K>::d__0), _primal, &(Subdomain<K>::_a->_n)); // _primal = R_b (G Q G^T) \ R f
                         }
                     }
                     else {
-                        super::_co->template callSolver<excluded>(super::_uc);
-                        std::fill(_primal, _primal + Subdomain<K>::_dof, 0.0);
+                        super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                        for(unsigned short k = 0; k < mu; ++k)
+                            std::fill_n(_primal + k * Subdomain<K>::_a->_n, Subdomain<K>::_dof, 0.0);
                     }
-                    A<'N', 0>(_primal, l);                                                               //       l = A R_b (G Q G^T) \ R f
-                    precond(l);                                                                          //       l = Q A R_b (G Q G^T) \ R f
-                    A<'T', 0>(_primal, l);                                                               // _primal = A^T Q A R_b (G Q G^T) \ R f
-                    std::fill(super::_structure, super::_structure + super::_bi->_m, 0.0);
-                    super::_p.solve(super::_structure);                                                  // _primal = S \ A^T Q A R_b (G Q G^T) \ R f
+                    A<'N', 0>(_primal, l, mu);                                                           //       l = A R_b (G Q G^T) \ R f
+                    precond(l, nullptr, mu);                                                             //       l = Q A R_b (G Q G^T) \ R f
+                    A<'T', 0>(_primal, l, mu);                                                           // _primal = A^T Q A R_b (G Q G^T) \ R f
+                    for(unsigned short k = 0; k < mu; ++k)
+                        std::fill_n(super::_structure + k * Subdomain<K>::_a->_n, super::_bi->_m, 0.0);
+                    super::_p.solve(super::_structure, mu);                                              // _primal = S \ A^T Q A R_b (G Q G^T) \ R f
                 }
                 else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                    super::_co->template callSolver<excluded>(super::_uc, 0, mu);
             }
             if(!excluded) {
-                super::_p.solve(f, x);                                                                   //       x = S \ f
+                std::copy_n(f, mu * Subdomain<K>::_a->_n, x);
+                super::_p.solve(x, mu);                                                                  //       x = S \ f
                 if(!super::_co) {
-                    A<'N', 0>(x + super::_bi->_m, r);                                                    //       r = A S \ f
-                    std::fill(*l, *l + super::_mult, 0.0);                                               //       l = 0
+                    A<'N', 0>(x + super::_bi->_m, r, mu);                                                //       r = A S \ f
+                    std::fill_n(*l, mu * super::_mult, 0.0);                                             //       l = 0
                 }
                 else {
-                    Wrapper<K>::axpby(Subdomain<K>::_dof, 1.0, x + super::_bi->_m, 1, -1.0, _primal, 1); // _primal = S \ (f - A^T Q A R_b (G Q G^T) \ R f)
-                    A<'N', 0>(_primal, r);                                                               //       r = A S \ (f - A^T Q A R_b (G Q G^T) \ R f)
-                    project<excluded, 'T'>(r);                                                           //       r = P^T r
+                    for(unsigned short k = 0; k < mu; ++k)
+                        Wrapper<K>::axpby(Subdomain<K>::_dof, 1.0, x + k * Subdomain<K>::_a->_n + super::_bi->_m, 1, -1.0, _primal + k * Subdomain<K>::_a->_n, 1); // _primal = S \ (f - A^T Q A R_b (G Q G^T) \ R f)
+                    A<'N', 0>(_primal, r, mu);                                                           //       r = A S \ (f - A^T Q A R_b (G Q G^T) \ R f)
+                    project<excluded, 'T'>(r, nullptr, mu);                                              //       r = P^T r
                 }
             }
             else if(super::_co)
-                project<excluded, 'T'>(r);
+                project<excluded, 'T'>(r, nullptr, mu);
         }
         /* Function: allocateSingle
          *
          *  Allocates a single Lagrange multiplier.
          *
-         * Parameter:
-         *    mult           - Reference to a Lagrange multiplier. */
-        inline void allocateSingle(K**& mult) const {
+         * Parameters:
+         *    mult           - Reference to a Lagrange multiplier.
+         *    mu             - Number of vectors stored contiguously (optional). */
+        inline void allocateSingle(K**& mult, const unsigned short& mu = 1) const {
             mult  = new K*[Subdomain<K>::_map.size()];
-            *mult = new K[super::_mult];
+            *mult = new K[mu * super::_mult];
             for(unsigned short i = 1; i < Subdomain<K>::_map.size(); ++i)
                 mult[i] = mult[i - 1] + Subdomain<K>::_map[i - 1].second.size();
         }
@@ -200,15 +289,16 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          * Template Parameter:
          *    N              - Size of the array.
          *
-         * Parameter:
-         *    array          - Reference to an array of Lagrange multipliers. */
+         * Parameters:
+         *    array          - Reference to an array of Lagrange multipliers.
+         *    mu             - Number of vectors stored contiguously in each Lagrange multiplier (optional). */
         template<unsigned short N>
-        inline void allocateArray(K** (&array)[N]) const {
+        inline void allocateArray(K** (&array)[N], const unsigned short& mu = 1) const {
             *array  = new K*[N * Subdomain<K>::_map.size()];
-            **array = new K[N * super::_mult];
+            **array = new K[N * mu * super::_mult];
             for(unsigned short i = 0; i < N; ++i) {
                 array[i]  = *array + i * Subdomain<K>::_map.size();
-                *array[i] = **array + i * super::_mult;
+                *array[i] = **array + i * mu * super::_mult;
                 for(unsigned short j = 1; j < Subdomain<K>::_map.size(); ++j)
                     array[i][j] = array[i][j - 1] + Subdomain<K>::_map[j - 1].second.size();
             }
@@ -248,12 +338,15 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
-        inline void apply(K* const* const in, K* const* const out = nullptr) const {
-            A<'T', 0>(_primal, in);
-            std::fill(super::_structure, super::_structure + super::_bi->_m, 0.0);
-            super::_p.solve(super::_structure);
-            A<'N', 0>(_primal, out ? out : in);
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Feti::allocateBlock>. */
+        inline void apply(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
+            A<'T', 0>(_primal, in, mu);
+            post(mu);
+            for(unsigned short k = 0; k < mu; ++k)
+                std::fill_n(super::_structure + k * Subdomain<K>::_a->_n, super::_bi->_m, 0.0);
+            super::_p.solve(super::_structure, mu);
+            A<'N', 0, true>(_primal, out ? out : in, mu);
         }
         /* Function: applyLocalPreconditioner(n)
          *
@@ -263,14 +356,15 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    q              - Type of <FetiPrcndtnr> to apply.
          *
          * Parameters:
-         *    u              - Input vectors.
-         *    n              - Number of input vectors. */
+         *    u              - Input vectors, overwritten by the output vectors.
+         *    n              - Number of input vectors.
+         *    work           - Workspace array of size <Schur::getWorkspace> (optional). */
         template<FetiPrcndtnr q = P>
-        inline void applyLocalPreconditioner(K*& u, unsigned short n) const {
+        inline void applyLocalPreconditioner(K* const u, unsigned short n, K* const work = nullptr) const {
             switch(q) {
-                case FetiPrcndtnr::DIRICHLET:   super::applyLocalSchurComplement(u, n); break;
-                case FetiPrcndtnr::LUMPED:      super::applyLocalLumpedMatrix(u, n); break;
-                case FetiPrcndtnr::SUPERLUMPED: super::applyLocalSuperlumpedMatrix(u, n); break;
+                case FetiPrcndtnr::DIRICHLET:   super::applyLocalSchurComplement(u, n, work); break;
+                case FetiPrcndtnr::LUMPED:      super::applyLocalLumpedMatrix(u, n, work); break;
+                case FetiPrcndtnr::SUPERLUMPED: super::applyLocalSuperlumpedMatrix(u, n, work); break;
                 case FetiPrcndtnr::NONE:        break;
             }
         }
@@ -294,16 +388,26 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         /* Function: precond
          *
-         *  Applies the global preconditioner to a single right-hand side.
+         *  Applies the global preconditioner to a single right-hand side, or to multiple right-hand sides, in which case the local preconditioner is applied to contiguous copies of the primal unknowns.
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Feti::allocateBlock>. */
         template<FetiPrcndtnr q = P>
-        inline void precond(K* const* const in, K* const* const out = nullptr) const {
-            A<'T', 1>(_primal, in);
-            applyLocalPreconditioner<q>(_primal);
-            A<'N', 1>(_primal, out ? out : in);
+        inline void precond(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
+            A<'T', 1>(_primal, in, mu);
+            post(mu);
+            if(mu == 1)
+                applyLocalPreconditioner<q>(_primal);
+            else {
+                K* const primal = super::_structure + mu * Subdomain<K>::_a->_n;
+                const int n = mu;
+                Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, _primal, &(Subdomain<K>::_a->_n), primal, &(Subdomain<K>::_dof));
+                applyLocalPreconditioner<q>(primal, mu, super::getBuffer(mu) + 2 * mu * super::_mult);
+                Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, primal, &(Subdomain<K>::_dof), _primal, &(Subdomain<K>::_a->_n));
+            }
+            A<'N', 1, true>(_primal, out ? out : in, mu);
         }
         /* Function: project
          *
@@ -315,48 +419,57 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    in             - Input vector.
-         *    out            - Output vector (optional). */
+         *    out            - Output vector (optional).
+         *    mu             - Number of vectors (optional), see <Feti::allocateBlock>. */
         template<bool excluded, char trans>
-        inline void project(K* const* const in, K* const* const out = nullptr) const {
+        inline void project(K* const* const in, K* const* const out = nullptr, const unsigned short& mu = 1) const {
             static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
             if(super::_co) {
                 if(!excluded) {
+                    const int n = mu;
                     if(trans == 'T')
-                        precond(in, _dual);
+                        precond(in, _dual, mu);
                     if(super::_ev) {
                         if(trans == 'T')
-                            A<'T', 0>(_primal, _dual);
+                            A<'T', 0>(_primal, _dual, mu);
                         else
-                            A<'T', 0>(_primal, in);
-                        if(super::_schur) {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), _primal, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);
+                            A<'T', 0>(_primal, in, mu);
+                        if(super::_evc) {
+                            super::template applyVectors<'T'>(_primal, super::_uc, mu, Subdomain<K>::_a->_n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            super::template applyVectors<'N'>(super::_uc, _primal, mu, Subdomain<K>::_a->_n);
+                        }
+                        else if(super::_schur || super::_hodlr || super::_lowRank) {
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _primal, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &n, &(Wrapper<K>::d__0), _primal, &(Subdomain<K>::_a->_n));
                         }
                         else {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), _primal, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
-                            super::_co->template callSolver<excluded>(super::_uc);
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _primal, &(Subdomain<K>::_a->_n), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), super::_uc, &n);
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), super::_uc, &n, &(Wrapper<K>::d__0), _primal, &(Subdomain<K>::_a->_n));
                         }
                     }
                     else {
-                        super::_co->template callSolver<excluded>(super::_uc);
-                        std::fill(_primal, _primal + Subdomain<K>::_dof, 0.0);
+                        super::_co->template callSolver<excluded>(super::_uc, 0, mu);
+                        for(unsigned short k = 0; k < mu; ++k)
+                            std::fill_n(_primal + k * Subdomain<K>::_a->_n, Subdomain<K>::_dof, 0.0);
                     }
-                    A<'N', 0>(_primal, _dual);
+                    A<'N', 0>(_primal, _dual, mu);
                     if(trans == 'N')
-                        precond(_dual);
+                        precond(_dual, nullptr, mu);
+                    const int size = mu * super::_mult;
                     if(out)
-                        for(unsigned int i = 0; i < super::_mult; ++i)
+                        for(int i = 0; i < size; ++i)
                             (*out)[i] = (*in)[i] - (*_dual)[i];
                     else
-                        Wrapper<K>::axpy(&(super::_mult), &(Wrapper<K>::d__2), *_dual, &i__1, *in, &i__1);
+                        Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), *_dual, &i__1, *in, &i__1);
                 }
                 else
-                    super::_co->template callSolver<excluded>(super::_uc);
+                    super::_co->template callSolver<excluded>(super::_uc, 0, mu);
             }
             else if(!excluded && out)
-                std::copy(*in, *in + super::_mult, *out);
+                std::copy_n(*in, mu * super::_mult, *out);
         }
         /* Function: buildTwo
          *
@@ -372,7 +485,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          * See also: <Bdd::buildTwo>, <Schwarz::buildTwo>.*/
         template<unsigned short excluded = 0, class Container>
         inline std::pair<MPI_Request, const K*>* buildTwo(const MPI_Comm& comm, Container& parm) {
-            if(!super::_schur && parm[NU])
+            if(!super::_schur && !super::_hodlr && !super::_lowRank && parm[NU])
                 super::_deficiency = parm[NU];
 #if 0
             if(P == FetiPrcndtnr::DIRICHLET || P == FetiPrcndtnr::LUMPED) {
@@ -396,43 +509,56 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    x              - Solution vector.
-         *    l              - Last iterate of the Lagrange multiplier. */
+         *    l              - Last iterate of the Lagrange multiplier.
+         *    mu             - Number of right-hand sides (optional), see <Feti::allocateBlock>. */
         template<bool excluded>
-        inline void computeSolution(K* const x, K* const* const l) const {
+        inline void computeSolution(K* const x, K* const* const l, const unsigned short& mu = 1) const {
             if(!excluded) {
-                A<'T', 0>(_primal, l);                                                                                                                                                                                                       //    _primal = A^T l
-                std::fill(super::_structure, super::_structure + super::_bi->_m, 0.0);
-                super::_p.solve(super::_structure);                                                                                                                                                                                          // _structure = S \ A^T l
-                Wrapper<K>::axpy(&(Subdomain<K>::_a->_n), &(Wrapper<K>::d__2), super::_structure, &i__1, x, &i__1);                                                                                                                          //          x = x - S \ A^T l
+                const int n = mu;
+                const int size = mu * Subdomain<K>::_a->_n;
+                A<'T', 0>(_primal, l, mu);                                                                                                                                                                                                                   //    _primal = A^T l
+                for(unsigned short k = 0; k < mu; ++k)
+                    std::fill_n(super::_structure + k * Subdomain<K>::_a->_n, super::_bi->_m, 0.0);
+                super::_p.solve(super::_structure, mu);                                                                                                                                                                                                      // _structure = S \ A^T l
+                Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), super::_structure, &i__1, x, &i__1);                                                                                                                                                            //          x = x - S \ A^T l
                 if(super::_co) {
-                    A<'N', 0>(x + super::_bi->_m, _dual);                                                                                                                                                                                    //      _dual = A (x - S \ A^T l)
-                    precond(_dual);                                                                                                                                                                                                          //      _dual = Q A (x - S \ A^T l)
+                    A<'N', 0>(x + super::_bi->_m, _dual, mu);                                                                                                                                                                                                //      _dual = A (x - S \ A^T l)
+                    precond(_dual, nullptr, mu);                                                                                                                                                                                                             //      _dual = Q A (x - S \ A^T l)
                     if(!super::_ev)
-                        super::_co->template callSolver<excluded>(super::_uc);
+                        super::_co->template callSolver<excluded>(super::_uc, 0, mu);
                     else {
-                        A<'T', 0>(_primal, _dual);                                                                                                                                                                                           //    _primal = A^T Q A (x - S \ A^T l)
-                        if(super::_schur) {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), _primal, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);                                       //        _uc = R_b^T A^T Q A (x - S \ A^T l)
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                           //        _uc = (G Q G^T) \ R_b^T A^T Q A (x - S \ A^T l)
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), _primal, &i__1);                   //        x_b = x_b - R_b^T (G Q G^T) \ R_b^T A^T Q A (x - S \ A^T l)
-                            Wrapper<K>::template csrmv<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, _primal, &(Wrapper<K>::d__0), super::_work);
-                            super::_s.solve(super::_work);
-                            Wrapper<K>::axpy(&(super::_bi->_m), &(Wrapper<K>::d__2), super::_work, &i__1, x, &i__1);
-                            Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), _primal, &i__1, x + super::_bi->_m, &i__1);
+                        A<'T', 0>(_primal, _dual, mu);                                                                                                                                                                                                       //    _primal = A^T Q A (x - S \ A^T l)
+                        if(super::_schur || super::_hodlr || super::_lowRank) {
+                            K* const work = mu == 1 ? super::_work : super::getBuffer(mu) + 2 * mu * super::_mult;
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _primal, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), super::_uc, &n);                         //        _uc = R_b^T A^T Q A (x - S \ A^T l)
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);                                                                                                                                                                    //        _uc = (G Q G^T) \ R_b^T A^T Q A (x - S \ A^T l)
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &n, &(Wrapper<K>::d__0), _primal, &(Subdomain<K>::_a->_n));          //        x_b = x_b - R_b^T (G Q G^T) \ R_b^T A^T Q A (x - S \ A^T l)
+                            if(mu == 1)
+                                Wrapper<K>::template csrmv<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, _primal, &(Wrapper<K>::d__0), work);
+                            else {
+                                K* const primal = super::_structure + mu * Subdomain<K>::_a->_n;
+                                Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, _primal, &(Subdomain<K>::_a->_n), primal, &(Subdomain<K>::_dof));
+                                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &n, &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, primal, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), work, &(super::_bi->_m));
+                            }
+                            super::_s.solve(work, mu);
+                            for(unsigned short k = 0; k < mu; ++k) {
+                                Wrapper<K>::axpy(&(super::_bi->_m), &(Wrapper<K>::d__2), work + k * super::_bi->_m, &i__1, x + k * Subdomain<K>::_a->_n, &i__1);
+                                Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), _primal + k * Subdomain<K>::_a->_n, &i__1, x + k * Subdomain<K>::_a->_n + super::_bi->_m, &i__1);
+                            }
                         }
                         else {
-                            Wrapper<K>::gemv(&transb, &(Subdomain<K>::_dof), super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), _primal, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1); //       _uc = R A^T Q A (x - S \ A^T l)
-                            super::_co->template callSolver<excluded>(super::_uc);                                                                                                                                                            //       _uc = (G Q G^T) \ R A^T Q A (x - S \ A^T l)
-                            Wrapper<K>::gemv(&transa, &(Subdomain<K>::_a->_n), super::_co->getAddrLocal(), &(Wrapper<K>::d__2), *super::_ev, &(Subdomain<K>::_a->_n), super::_uc, &i__1, &(Wrapper<K>::d__1), x, &i__1);                      //         x = x - R^T (G Q G^T) \ R A^T Q A (x - S \ A^T l)
+                            Wrapper<K>::gemm(&transb, &transa, &n, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _primal, &(Subdomain<K>::_a->_n), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), super::_uc, &n); //        _uc = R A^T Q A (x - S \ A^T l)
+                            super::_co->template callSolver<excluded>(super::_uc, 0, mu);                                                                                                                                                                    //        _uc = (G Q G^T) \ R A^T Q A (x - S \ A^T l)
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_a->_n), &n, super::_co->getAddrLocal(), &(Wrapper<K>::d__2), *super::_ev, &(Subdomain<K>::_a->_n), super::_uc, &n, &(Wrapper<K>::d__1), x, &(Subdomain<K>::_a->_n));                  //          x = x - R^T (G Q G^T) \ R A^T Q A (x - S \ A^T l)
                         }
                     }
                 }
             }
             else if(super::_co)
-                super::_co->template callSolver<excluded>(super::_uc);
+                super::_co->template callSolver<excluded>(super::_uc, 0, mu);
         }
         template<bool excluded>
-        inline void computeSolution(K* const x, const K* const f) const { }
+        inline void computeSolution(K* const, const K* const, const unsigned short& = 1) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two Lagrange multipliers.
@@ -442,14 +568,16 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    mu             - Number of vectors (optional), in which case mu dot products are computed. */
         template<bool excluded>
-        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm) const {
+        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
             if(!excluded)
-                *val = Wrapper<K>::dot(&(super::_mult), *a, &i__1, *b, &i__1) / 2.0;
+                for(unsigned short k = 0; k < mu; ++k)
+                    val[k] = Wrapper<K>::dot(&(super::_mult), *a + k * super::_mult, &i__1, *b + k * super::_mult, &i__1) / 2.0;
             else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                std::fill_n(val, mu, 0.0);
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Feti::m>. */
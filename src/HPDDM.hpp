@@ -29,19 +29,17 @@
  *    HPDDM_VERSION       - Version of the framework.
  *    HPDDM_EPS           - Small positive number used internally for dropping values.
  *    HPDDM_PEN           - Large positive number used externally for penalization, e.g. for imposing Dirichlet boundary conditions.
- *    HPDDM_MAXCO         - Assumed maximum connectivity between subdomains.
- *    HPDDM_GRANULARITY   - Granularity for OpenMP scheduling.
+ *    HPDDM_GRANULARITY   - Default granularity for OpenMP scheduling, see the runtime option granularity in <Option>.
  *    HPDDM_OUTPUT_CO     - If set to one, the coarse operator is saved to disk (for debugging only).
  *    HPDDM_MKL           - If not set to zero, Intel MKL is chosen as the linear algebra back end.
  *    HPDDM_SCHWARZ       - Overlapping Schwarz methods enabled.
  *    HPDDM_FETI          - FETI methods enabled.
  *    HPDDM_BDD           - BDD methods enabled.
- *    HPDDM_ICOLLECTIVE   - If possible, use nonblocking MPI collective operations.
- *    HPDDM_GMV           - For overlapping Schwarz methods, this can be used to reduce the volume of communication for computing global matrix-vector products. */
+ *    HPDDM_ICOLLECTIVE   - If possible, use nonblocking MPI collective operations, see also the runtime option async in <Option>.
+ *    HPDDM_GMV           - For overlapping Schwarz methods, this can be used to reduce the volume of communication for computing global matrix-vector products, see the runtime option gmv in <Option>. */
 #define HPDDM_VERSION         000001
 #define HPDDM_EPS             1.0e-12
 #define HPDDM_PEN             1.0e+30
-#define HPDDM_MAXCO           20
 #define HPDDM_GRANULARITY     50000
 #define HPDDM_OUTPUT_CO       0
 #define HPDDM_MKL             0
@@ -95,6 +93,15 @@ static_assert(2 * sizeof(double) == sizeof(std::complex<double>) && 2 * sizeof(f
 void    HPDDM_F77(C ## axpy)(const int*, const T*, const T*, const int*, T*, const int*);                    \
 void    HPDDM_F77(C ## scal)(const int*, const T*, T*, const int*);                                          \
 void   HPDDM_F77(C ## lacpy)(const char*, const int*, const int*, const T*, const int*, T*, const int*);     \
+void   HPDDM_F77(C ## getrf)(const int*, const int*, T*, const int*, int*, int*);                            \
+void   HPDDM_F77(C ## getrs)(const char*, const int*, const int*, const T*, const int*, const int*, T*,      \
+                             const int*, int*);                                                              \
+void   HPDDM_F77(C ## potrf)(const char*, const int*, T*, const int*, int*);                                 \
+void   HPDDM_F77(C ## potrs)(const char*, const int*, const int*, const T*, const int*, T*, const int*,      \
+                             int*);                                                                          \
+void   HPDDM_F77(C ## sytrf)(const char*, const int*, T*, const int*, int*, T*, const int*, int*);           \
+void   HPDDM_F77(C ## sytrs)(const char*, const int*, const int*, const T*, const int*, const int*, T*,      \
+                             const int*, int*);                                                              \
 void    HPDDM_F77(C ## symv)(const char*, const int*, const T*, const T*, const int*,                        \
                              const T*, const int*, const T*, T*, const int*);                                \
 void    HPDDM_F77(C ## gemv)(const char*, const int*, const int*, const T*,                                  \
@@ -168,7 +175,7 @@ static constexpr char uplo   =  'L';
 static constexpr int i__0    =    0;
 static constexpr int i__1    =    1;
 
-typedef std::pair<unsigned short, std::vector<int>>  pairNeighbor; // MPI_Comm_size < MAX_UNSIGNED_SHORT
+typedef std::pair<int, std::vector<int>>            pairNeighbor;
 typedef std::vector<pairNeighbor>                  vectorNeighbor;
 #ifdef __GNUG__
 std::string demangle(const char* name) {
@@ -183,6 +190,7 @@ std::string demangle(const char* name) {
 #endif // __GNUG__
 } // HPDDM
 #include "enum.hpp"
+#include "option.hpp"
 #include "wrapper.hpp"
 #include "matrix.hpp"
 #include "dmatrix.hpp"
@@ -206,6 +214,7 @@ std::string demangle(const char* name) {
 #if defined(DPASTIX) || defined(PASTIXSUB)
 #include "PaStiX.hpp"
 #endif
+#include "dense_LAPACK.hpp"
 #include "SuiteSparse.hpp"
 #include "eigensolver.hpp"
 #if HPDDM_SCHWARZ
@@ -215,6 +224,7 @@ std::string demangle(const char* name) {
 #endif
 #if HPDDM_BDD || HPDDM_FETI
 #include "LAPACK.hpp"
+#include "hodlr.hpp"
 #endif
 
 #include "preconditioner.hpp"
@@ -235,6 +245,9 @@ using HpFeti = HPDDM::Feti<SUBDOMAIN, COARSEOPERATOR, S, K, P>;
 #include "BDD.hpp"
 template<class K = double, char S = 'S'>
 using HpBdd = HPDDM::Bdd<SUBDOMAIN, COARSEOPERATOR, S, K>;
+#include "BDDC.hpp"
+template<class K = double, char S = 'S'>
+using HpBddc = HPDDM::Bddc<SUBDOMAIN, COARSEOPERATOR, S, K>;
 #endif
 
 #include "iterative.hpp"
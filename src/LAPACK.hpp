@@ -23,8 +23,9 @@
 #ifndef _LAPACK_
 #define _LAPACK_
 
+#include <random>
+
 #define HPDDM_GENERATE_EXTERN_LAPACK(C, T, U, SYM, ORT)                                                      \
-void HPDDM_F77(C ## potrf)(const char*, const int*, T*, const int*, int*);                                   \
 void HPDDM_F77(C ## trtrs)(const char*, const char*, const char*, const int*, const int*, const T*,          \
                            const int*, T*, const int*, int*);                                                \
 void HPDDM_F77(C ## SYM ## gst)(const int*, const char*, const int*, T*, const int*,                         \
@@ -33,7 +34,10 @@ void HPDDM_F77(C ## SYM ## trd)(const char*, const int*, T*, const int*, U*, U*,
 void HPDDM_F77(C ## stein)(const int*, const U*, const U*, const int*, const U*, const int*,                 \
                            const int*, T*, const int*, U*, int*, int*, int*);                                \
 void HPDDM_F77(C ## ORT ## mtr)(const char*, const char*, const char*, const int*, const int*,               \
-                                const T*, const int*, const T*, T*, const int*, T*, const int*, int*);
+                                const T*, const int*, const T*, T*, const int*, T*, const int*, int*);       \
+void HPDDM_F77(C ## geqrf)(const int*, const int*, T*, const int*, T*, T*, const int*, int*);                \
+void HPDDM_F77(C ## ORT ## gqr)(const int*, const int*, const int*, T*, const int*, const T*, T*,            \
+                                const int*, int*);
 
 #if !defined(INTEL_MKL_VERSION)
 extern "C" {
@@ -56,9 +60,6 @@ namespace HPDDM {
 template<class K>
 class Lapack : public Eigensolver<K> {
     private:
-        /* Function: potrf
-         *  Computes the Cholesky factorization of a symmetric or Hermitian positive definite matrix. */
-        static inline void potrf(const char*, const int*, K*, const int*, int*);
         /* Function: trtrs
          *  Solves a system of linear equations with a triangular matrix. */
         static inline void trtrs(const char*, const char*, const char*, const int*, const int*, const K*, const int*, K*, const int*, int*);
@@ -77,6 +78,12 @@ class Lapack : public Eigensolver<K> {
         /* Function: mtr
          *  Multiplies a matrix by a orthogonal or unitary matrix obtained with <Lapack::trd>. */
         static inline void mtr(const char*, const char*, const char*, const int*, const int*, const K*, const int*, const K*, K*, const int*, K*, const int*, int*);
+        /* Function: geqrf
+         *  Computes a QR factorization of a general rectangular matrix. */
+        static inline void geqrf(const int*, const int*, K*, const int*, K*, K*, const int*, int*);
+        /* Function: gqr
+         *  Generates the orthogonal or unitary matrix Q of a QR factorization computed with <Lapack::geqrf>. */
+        static inline void gqr(const int*, const int*, const int*, K*, const int*, const K*, K*, const int*, int*);
     public:
         Lapack(int n, int nu)                                                                           : Eigensolver<K>(n, nu) { }
         Lapack(typename Wrapper<K>::ul_type threshold, int n, int nu)                                   : Eigensolver<K>(threshold, n, nu) { }
@@ -90,7 +97,7 @@ class Lapack : public Eigensolver<K> {
          *    B              - Right-hand side matrix. */
         inline void reduce(K* const& A, K* const& B) const {
             int info;
-            potrf(&uplo, &(Eigensolver<K>::_n), B, &(Eigensolver<K>::_n), &info);
+            Wrapper<K>::potrf(&uplo, &(Eigensolver<K>::_n), B, &(Eigensolver<K>::_n), &info);
             gst(&i__1, &uplo, &(Eigensolver<K>::_n), A, &(Eigensolver<K>::_n), B, &(Eigensolver<K>::_n), &info);
         }
         /* Function: expand
@@ -151,14 +158,156 @@ class Lapack : public Eigensolver<K> {
             }
             delete [] iblock;
         }
+        /* Function: partial
+         *
+         *  Computes eigenvectors of the standard eigenvalue problem Ax = l x associated to the <Eigensolver::nu> smallest eigenvalues, without reducing A to a tridiagonal form. A is shifted by a small multiple of its norm and factorized, and a block of vectors is updated by subspace iterations with the inverse of the shifted matrix followed by Rayleigh-Ritz projections, until the residuals of the wanted eigenpairs are small enough relative to the norm and the dimension of A. The work is thus mostly done in threaded BLAS 3 routines. If the block is not much smaller than A, if the shifted matrix is not positive definite, or if the iterations do not converge, <Lapack::solve> is called instead. Contrary to <Lapack::solve>, no more than <Eigensolver::nu> eigenpairs are computed when using a threshold criterion.
+         *
+         * Parameters:
+         *    A              - Left-hand side matrix.
+         *    ev             - Array of eigenvectors.
+         *    work           - Workspace array.
+         *    lwork          - Size of the input workspace array.
+         *    communicator   - MPI communicator for selecting the threshold criterion. */
+        inline void partial(K* const& A, K**& ev, K* const& work, int& lwork, const MPI_Comm& communicator) {
+            const int n = Eigensolver<K>::_n;
+            int m = std::min(n, Eigensolver<K>::_nu + std::max(Eigensolver<K>::_nu / 2, 10));
+            if(4 * m > n) {
+                solve(A, ev, work, lwork, communicator);
+                return;
+            }
+            typename Wrapper<K>::ul_type* evr = new typename Wrapper<K>::ul_type[n + 10 * m];
+            typename Wrapper<K>::ul_type* d = evr + m;
+            typename Wrapper<K>::ul_type* e = d + m;
+            typename Wrapper<K>::ul_type* rw = e + m;
+            typename Wrapper<K>::ul_type* diagonal = rw + 7 * m;
+            typename Wrapper<K>::ul_type norm = 0.0;
+            for(int j = 0; j < n; ++j) {
+                diagonal[j] = std::real(A[j + j * n]);
+                typename Wrapper<K>::ul_type sum = 0.0;
+                for(int i = 0; i < j; ++i)
+                    sum += std::abs(A[i + j * n]);
+                for(int i = j; i < n; ++i) {
+                    sum += std::abs(A[i + j * n]);
+                    A[j + i * n] = A[i + j * n];
+                }
+                conjugate(j, 1, n, A + j * n);
+                norm = std::max(norm, sum);
+            }
+            const typename Wrapper<K>::ul_type shift = std::sqrt(std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) * norm;
+            for(int j = 0; j < n; ++j)
+                A[j + j * n] += shift;
+            auto restore = [&]() {
+                for(int j = 0; j < n; ++j) {
+                    A[j + j * n] = diagonal[j];
+                    for(int i = j + 1; i < n; ++i)
+                        A[i + j * n] = A[j + i * n];
+                    conjugate(n - j - 1, 1, n, A + j + 1 + j * n);
+                }
+            };
+            int info;
+            Wrapper<K>::potrf(&uplo, &n, A, &n, &info);
+            if(info) {
+                restore();
+                delete [] evr;
+                solve(A, ev, work, lwork, communicator);
+                return;
+            }
+            int lw = 64 * m;
+            K* const buffer = new K[3 * n * m + 4 * m * m + m + lw];
+            K* x = buffer;
+            K* y = x + n * m;
+            K* z = y + n * m;
+            K* h = z + n * m;
+            K* q = h + m * m;
+            K* r = q + m * m;
+            K* t = r + m * m;
+            K* tau = t + m * m;
+            K* w = tau + m;
+            int* iblock = new int[6 * m];
+            int* isplit = iblock + m;
+            int* ifailv = isplit + m;
+            int* iw = ifailv + m;
+            std::mt19937 gen(n);
+            std::normal_distribution<typename Wrapper<K>::ul_type> dist;
+            std::generate_n(x, n * m, [&]() { return K(dist(gen)); });
+            geqrf(&n, &m, x, &n, tau, w, &lw, &info);
+            gqr(&n, &m, &m, x, &n, tau, w, &lw, &info);
+            char range = 'A';
+            char order = 'B';
+            char side = 'L';
+            char upper = 'U';
+            int il = 1, iu = 1, nsplit, found;
+            typename Wrapper<K>::ul_type vl = 0.0, vu = 0.0, abstol = 0.0;
+            const typename Wrapper<K>::ul_type tol = std::max(1.0e+2, static_cast<typename Wrapper<K>::ul_type>(n)) * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() * norm;
+            bool converged = false;
+            for(unsigned short it = 0; it < 200 && !converged; ++it) {
+                std::copy_n(x, n * m, y);
+                trtrs(&uplo, &transa, &transa, &n, &m, A, &n, y, &n, &info);
+                trtrs(&uplo, &(Wrapper<K>::transc), &transa, &n, &m, A, &n, y, &n, &info);
+                Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &m, &m, &n, &(Wrapper<K>::d__1), y, &n, x, &n, &(Wrapper<K>::d__0), t, &m);
+                geqrf(&n, &m, y, &n, tau, w, &lw, &info);
+                for(int j = 0; j < m; ++j) {
+                    std::copy_n(y + j * n, j + 1, r + j * m);
+                    std::fill(r + j * m + j + 1, r + (j + 1) * m, K());
+                }
+                gqr(&n, &m, &m, y, &n, tau, w, &lw, &info);
+                trtrs(&upper, &(Wrapper<K>::transc), &transa, &m, &m, r, &m, t, &m, &info);
+                for(int j = 0; j < m; ++j)
+                    for(int i = 0; i < m; ++i)
+                        h[j + i * m] = t[i + j * m];
+                conjugate(m, m, m, h);
+                trtrs(&upper, &(Wrapper<K>::transc), &transa, &m, &m, r, &m, h, &m, &info);
+                trd(&uplo, &m, h, &m, d, e, tau, w, &lw, &info);
+                stebz(&range, &order, &m, &vl, &vu, &il, &iu, &abstol, d, e, &found, &nsplit, evr, iblock, isplit, rw, iw, &info);
+                stein(&m, d, e, &found, evr, iblock, isplit, q, &m, rw, iw, ifailv, &info);
+                mtr(&side, &uplo, &transa, &m, &m, h, &m, tau, q, &m, w, &lw, &info);
+                std::vector<int> perm(m);
+                std::iota(perm.begin(), perm.end(), 0);
+                std::sort(perm.begin(), perm.end(), [&](int lhs, int rhs) { return evr[lhs] < evr[rhs]; });
+                for(int i = 0; i < m; ++i) {
+                    std::copy_n(q + perm[i] * m, m, h + i * m);
+                    rw[i] = evr[perm[i]];
+                }
+                std::copy_n(rw, m, evr);
+                std::copy_n(h, m * Eigensolver<K>::_nu, t);
+                trtrs(&upper, &transa, &transa, &m, &(Eigensolver<K>::_nu), r, &m, t, &m, &info);
+                Wrapper<K>::gemm(&transa, &transa, &n, &(Eigensolver<K>::_nu), &m, &(Wrapper<K>::d__1), x, &n, t, &m, &(Wrapper<K>::d__0), z, &n);
+                Wrapper<K>::gemm(&transa, &transa, &n, &m, &m, &(Wrapper<K>::d__1), y, &n, h, &m, &(Wrapper<K>::d__0), x, &n);
+                converged = true;
+                for(int i = 0; i < Eigensolver<K>::_nu && converged; ++i) {
+                    K alpha = -evr[i];
+                    Wrapper<K>::axpy(&n, &alpha, x + i * n, &i__1, z + i * n, &i__1);
+                    converged = Wrapper<K>::nrm2(&n, z + i * n, &i__1) < tol;
+                }
+            }
+            if(!converged) {
+                restore();
+                delete [] iblock;
+                delete [] buffer;
+                delete [] evr;
+                solve(A, ev, work, lwork, communicator);
+                return;
+            }
+            for(int i = 0; i < m; ++i)
+                evr[i] -= shift;
+            std::copy_n(evr, Eigensolver<K>::_nu, reinterpret_cast<typename Wrapper<K>::ul_type*>(work) + lwork);
+            if(Eigensolver<K>::_threshold > 0.0)
+                Eigensolver<K>::selectNu(evr, communicator);
+            if(Eigensolver<K>::_nu) {
+                ev = new K*[Eigensolver<K>::_nu];
+                *ev = new K[n * Eigensolver<K>::_nu];
+                for(unsigned short i = 1; i < Eigensolver<K>::_nu; ++i)
+                    ev[i] = *ev + i * n;
+                std::copy_n(x, n * Eigensolver<K>::_nu, *ev);
+            }
+            delete [] iblock;
+            delete [] buffer;
+            delete [] evr;
+        }
 };
 
 #define HPDDM_GENERATE_LAPACK(C, T, B, U, SYM, ORT)                                                          \
 template<>                                                                                                   \
-inline void Lapack<T>::potrf(const char* uplo, const int* n, T* a, const int* lda, int* info) {              \
-    HPDDM_F77(C ## potrf)(uplo, n, a, lda, info);                                                            \
-}                                                                                                            \
-template<>                                                                                                   \
 inline void Lapack<T>::trtrs(const char* uplo, const char* trans, const char* diag, const int* n,            \
                              const int* nrhs, const T* a, const int* lda, T* b, const int* ldb, int* info) { \
     HPDDM_F77(C ## trtrs)(uplo, trans, diag, n, nrhs, a, lda, b, ldb, info);                                 \
@@ -191,6 +340,16 @@ inline void Lapack<T>::stebz(const char* range, const char* order, const int* n,
                              int* nsplit, U* w, int* iblock, int* isplit, U* work, int* iwork, int* info) {  \
     HPDDM_F77(B ## stebz)(range, order, n, vl, vu, il, iu, abstol, d, e, m, nsplit, w, iblock, isplit,       \
                           work, iwork, info);                                                                \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Lapack<T>::geqrf(const int* m, const int* n, T* a, const int* lda, T* tau, T* work,              \
+                             const int* lwork, int* info) {                                                  \
+    HPDDM_F77(C ## geqrf)(m, n, a, lda, tau, work, lwork, info);                                             \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Lapack<T>::gqr(const int* m, const int* n, const int* k, T* a, const int* lda, const T* tau,     \
+                           T* work, const int* lwork, int* info) {                                           \
+    HPDDM_F77(C ## ORT ## gqr)(m, n, k, a, lda, tau, work, lwork, info);                                     \
 }
 HPDDM_GENERATE_LAPACK(s, float, s, float, sy, or)
 HPDDM_GENERATE_LAPACK(d, double, d, double, sy, or)
@@ -85,6 +85,9 @@ class MklPardiso : public DMatrix {
         /* Variable: w
          *  Workspace array. */
         K*              _w;
+        /* Variable: mu
+         *  Number of right-hand sides that fit in <MKL Pardiso::w>. */
+        unsigned short _mu;
         /* Variable: mtype
          *  Matrix type. */
         int         _mtype;
@@ -98,8 +101,11 @@ class MklPardiso : public DMatrix {
         /* Variable: numbering
          *  0-based indexing. */
         static constexpr char _numbering = 'C';
+        /* Typedef: integer_type
+         *  Type of the row pointers and column indices. */
+        typedef int integer_type;
     public:
-        MklPardiso() : _pt(), _C(), _I(), _J(), _w(), _comm(-1) { }
+        MklPardiso() : _pt(), _C(), _I(), _J(), _w(), _mu(1), _comm(-1) { }
         ~MklPardiso() {
             delete [] _w;
             int phase = -1;
@@ -171,14 +177,23 @@ class MklPardiso : public DMatrix {
          *    D              - Distribution of right-hand sides and solution vectors.
          *
          * Parameters:
-         *    rhs            - Input right-hand side, solution vector is stored in-place.
-         *    fuse           - Number of fused reductions (optional). */
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides, stored one after the other with a leading dimension equal to the local number of rows. */
         template<DMatrix::Distribution D>
-        inline void solve(K* rhs, const unsigned short& fuse = 0) {
+        inline void solve(K* rhs, const unsigned short& n = 1) {
             int error;
             int phase = 33;
+            int nrhs = n;
             K ddum;
-            CLUSTER_SPARSE_SOLVER(_pt, const_cast<int*>(&i__1), const_cast<int*>(&i__1), &_mtype, &phase, &(DMatrix::_n), _C, _I, _J, const_cast<int*>(&i__1), const_cast<int*>(&i__1), _iparm, const_cast<int*>(&i__0), rhs, _w, const_cast<int*>(&_comm), &error);
+            if(n > _mu) {
+                delete [] _w;
+                _mu = n;
+                if(DMatrix::_distribution == DMatrix::NON_DISTRIBUTED && DMatrix::_rank == 0)
+                    _w = new K[_mu * DMatrix::_n];
+                else
+                    _w = new K[_mu * (_iparm[41] - _iparm[40] + 1)];
+            }
+            CLUSTER_SPARSE_SOLVER(_pt, const_cast<int*>(&i__1), const_cast<int*>(&i__1), &_mtype, &phase, &(DMatrix::_n), _C, _I, _J, const_cast<int*>(&i__1), &nrhs, _iparm, const_cast<int*>(&i__0), rhs, _w, const_cast<int*>(&_comm), &error);
         }
         /* Function: initialize
          *
@@ -87,6 +87,9 @@ class Mumps : public DMatrix {
         /* Variable: numbering
          *  1-based indexing. */
         static constexpr char _numbering = 'F';
+        /* Typedef: integer_type
+         *  Type of the row and column indices, 64-bit if MUMPS is compiled with 64-bit integers. */
+        typedef MUMPS_INT integer_type;
     public:
         Mumps() : _id() { }
         ~Mumps() {
@@ -107,9 +110,10 @@ class Mumps : public DMatrix {
          *    nz             - Number of nonzero entries.
          *    I              - Array of row indices.
          *    J              - Array of column indices.
-         *    C              - Array of data. */
+         *    C              - Array of data.
+         *    block          - Size of the dense blocks if the matrix is made of square blocks of constant size, zero otherwise (optional). */
         template<char S>
-        inline void numfact(unsigned int nz, int* I, int* J, K* C) {
+        inline void numfact(std::size_t nz, integer_type* I, integer_type* J, K* C, unsigned short block = 0) {
             _id = new typename MUMPS_STRUC_C<K>::trait;
             _id->job = -1; _id->par = 1; _id->comm_fortran = MPI_Comm_c2f(DMatrix::_communicator);
             if(S == 'S')
@@ -118,7 +122,11 @@ class Mumps : public DMatrix {
                 _id->sym = 0;
             MUMPS_STRUC_C<K>::mumps_c(_id);
             _id->n = DMatrix::_n;
+#ifdef MUMPS_INT8
+            _id->nnz_loc = nz;
+#else
             _id->nz_loc = nz;
+#endif
             _id->irn_loc = I;
             _id->jcn_loc = J;
             _id->a_loc = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(C);
@@ -145,6 +153,8 @@ class Mumps : public DMatrix {
             _id->icntl[17] = 3;                 // distributed matrix input
             _id->icntl[19] = 0;                 // dense RHS
             _id->icntl[13] = 75;                // percentage increase in the estimated working space
+            if(block > 1 && _id->icntl[27] != 2)
+                _id->icntl[14] = -block;        // compression of the graph during analysis, ignored by MUMPS < 5.3.0
             _id->job = 4;
             MUMPS_STRUC_C<K>::mumps_c(_id);
             if(DMatrix::_rank == 0) {
@@ -164,15 +174,18 @@ class Mumps : public DMatrix {
          * Template Parameter:
          *    D              - Distribution of right-hand sides and solution vectors.
          *
-         * Parameter:
-         *    rhs            - Input right-hand side, solution vector is stored in-place. */
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides, stored one after the other with a leading dimension equal to <DMatrix::n>. */
         template<DMatrix::Distribution D>
-        inline void solve(K* rhs) {
+        inline void solve(K* rhs, const unsigned short& n = 1) {
+            _id->nrhs = n;
+            _id->lrhs = DMatrix::_n;
             if(D == DMatrix::DISTRIBUTED_SOL) {
                 _id->icntl[20] = 1;
                 int info = _id->info[22];
                 int isol_loc[info];
-                K* sol_loc = new K[info];
+                K* sol_loc = new K[n * info];
                 _id->sol_loc = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(sol_loc);
                 _id->lsol_loc = info;
                 _id->isol_loc = isol_loc;
@@ -183,6 +196,8 @@ class Mumps : public DMatrix {
                     DMatrix::initializeMap<0>(info, _id->isol_loc, sol_loc, rhs);
                 else
                     DMatrix::redistribute<0>(sol_loc, rhs);
+                for(unsigned short i = 1; i < n; ++i)
+                    DMatrix::redistribute<0>(sol_loc + i * info, rhs + i * DMatrix::_n);
                 delete [] sol_loc;
             }
             else {
@@ -210,7 +225,7 @@ class Mumps : public DMatrix {
             }
             else
                 DMatrix::_distribution = static_cast<DMatrix::Distribution>(parm[DISTRIBUTION]);
-            _strategy = parm[STRATEGY];
+            _strategy = Option::get().val<char>("strategy", parm[STRATEGY]);
         }
 };
 
@@ -253,7 +268,7 @@ class MumpsSub {
             _id->a = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(A->_a);
             int* listvar = nullptr;
             if(_id->job == -1) {
-                _strategy = 3;
+                _strategy = Option::get().val<char>("sub_strategy", 3);
                 _id->nrhs = 1;
                 _id->icntl[0] = 0; _id->icntl[1] = 0; _id->icntl[2] = 0; _id->icntl[3] = 0;
                 _id->icntl[4] = 0;
@@ -276,6 +291,26 @@ class MumpsSub {
                 _id->icntl[17] = 0;
                 _id->icntl[19] = 0;
                 _id->icntl[13] = 80;
+                if(Option::get().val<bool>("sub_ooc", false)) {
+                    _id->icntl[21] = 1;                                 // out-of-core factorization
+                    int rank;
+                    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+                    const char* const dir = std::getenv("HPDDM_OOC_TMPDIR");
+                    if(dir) {
+                        std::string tmpdir(dir);
+                        std::string::size_type pos = tmpdir.find("%d");
+                        if(pos != std::string::npos)
+                            tmpdir.replace(pos, 2, std::to_string(rank));
+                        *std::copy_n(tmpdir.cbegin(), std::min(tmpdir.size(), sizeof(_id->ooc_tmpdir) - 1), _id->ooc_tmpdir) = '\0';
+                    }
+                    const std::string prefix = "hpddm_" + std::to_string(rank) + "_";
+                    *std::copy_n(prefix.cbegin(), std::min(prefix.size(), sizeof(_id->ooc_prefix) - 1), _id->ooc_prefix) = '\0';
+                }
+                const double blr = Option::get().val("sub_blr", 0.0);
+                if(blr > 0.0) {
+                    _id->icntl[34] = 2;                                 // block low-rank factorization and solution
+                    _id->cntl[6]   = blr;                               // dropping parameter of the low-rank approximations
+                }
                 _id->n = A->_n;
                 _id->lrhs = A->_n;
                 _I = new int[A->_nnz];
@@ -302,6 +337,16 @@ class MumpsSub {
             delete [] listvar;
             if(_id->infog[0] != 0)
                 std::cerr << "BUG MUMPS, INFOG(1) = " << _id->infog[0] << std::endl;
+            else if(_id->icntl[21] == 1 || _id->icntl[34] == 2) {
+                int rank;
+                MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+                if(rank == 0) {
+                    // negative values are expressed in millions of entries
+                    const double full = _id->infog[19] < 0 ? -1.0e+6 * _id->infog[19] : _id->infog[19];
+                    const double effective = _id->infog[28] < 0 ? -1.0e+6 * _id->infog[28] : _id->infog[28];
+                    std::cout << "                 (subdomain memory: " << _id->infog[21] << "MB" << (_id->icntl[21] == 1 ? " -- out-of-core" : "") << " -- compression ratio of the factors: " << (effective > 0.0 ? full / effective : 1.0) << ")" << std::endl;
+                }
+            }
             std::transform(A->_ja, A->_ja + A->_nnz, A->_ja, [](int i){ return --i; });
         }
         inline unsigned short deficiency() const { return _id->infog[27]; }
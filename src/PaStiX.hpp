@@ -123,6 +123,9 @@ class Pastix : public DMatrix {
         /* Variable: numbering
          *  1-based indexing. */
         static constexpr char _numbering = 'F';
+        /* Typedef: integer_type
+         *  Type of the row pointers and column indices, 64-bit if PaStiX is compiled with 64-bit integers. */
+        typedef pastix_int_t integer_type;
     public:
         Pastix() : _data(), _values2(), _dparm(), _colptr2(), _rows2(), _loc2glob2(), _iparm() { }
         ~Pastix() {
@@ -154,7 +157,7 @@ class Pastix : public DMatrix {
          *    J              - Array of column indices.
          *    C              - Array of data. */
         template<char S>
-        inline void numfact(unsigned int ncol, int* I, int* loc2glob, int* J, K* C) {
+        inline void numfact(unsigned int ncol, integer_type* I, integer_type* loc2glob, integer_type* J, K* C) {
             _iparm = new pastix_int_t[IPARM_SIZE];
             _dparm = new double[DPARM_SIZE];
 
@@ -260,6 +263,7 @@ class Pastix : public DMatrix {
 #define SUBDOMAIN HPDDM::PastixSub
 template<class K>
 class PastixSub {
+    static_assert(sizeof(pastix_int_t) == sizeof(int), "Local solvers only support PaStiX compiled with 32-bit integers");
     private:
         pastix_data_t*    _data;
         K*              _values;
@@ -145,6 +145,9 @@ class SuiteSparse : public DMatrix {
         /* Variable: numbering
          *  0-based indexing. */
         static constexpr char _numbering = 'C';
+        /* Typedef: integer_type
+         *  Type of the row and column indices. */
+        typedef int integer_type;
     public:
         SuiteSparse() : _L(), _c(), _b(), _x(), _Y(), _E(), _numeric(), _control(), _pattern(), _W(), _tmp() { }
         ~SuiteSparse() {
@@ -370,7 +373,7 @@ class SuiteSparseSub {
                     a  = new K[nnz];
                     nnz = 0;
                     unsigned int i;
-#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+#pragma omp parallel for schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY))
                     for(i = 0; i < A->_n; ++i)
                         std::sort(v[i].begin(), v[i].end(), [](const std::pair<unsigned int, K>& lhs, const std::pair<unsigned int, K>& rhs) { return lhs.first < rhs.first; });
                     ia[0] = 0;
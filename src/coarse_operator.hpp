@@ -34,6 +34,9 @@
 #define HPDDM_CONTIGUOUS
 #endif
 #endif
+#if defined(DMUMPS) || defined(DLAPACK) || defined(DMKL_PARDISO)
+#define HPDDM_MULTIPLE_RHS
+#endif
 
 namespace HPDDM {
 /* Class: Coarse operator
@@ -67,6 +70,67 @@ class CoarseOperator : public Solver<K> {
          *  Local size of right-hand sides and solution vectors. */
         unsigned int              _sizeRHS;
         bool                       _offset;
+        /* Variable: work
+         *  Workspace array for solving coarse systems with multiple right-hand sides. */
+        K*                           _work;
+        /* Variable: sizeWork
+         *  Size of <Coarse operator::work>. */
+        unsigned int             _sizeWork;
+        /* Function: solveColumns
+         *
+         *  Solves a coarse system for multiple right-hand sides stored one coarse degree of freedom after the other, by first copying them one after the other in <Coarse operator::work>.
+         *
+         * Template Parameter:
+         *    D              - <DMatrix::Distribution> of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    offset         - Offset of the first coarse degree of freedom handled by the solver.
+         *    mu             - Number of right-hand sides. */
+        template<typename Solver<K>::Distribution D>
+        inline void solveColumns(K* const rhs, const unsigned int& offset, const unsigned short& mu) {
+            if(mu == 1)
+                Solver<K>::template solve<D>(rhs + offset);
+            else {
+#ifdef HPDDM_MULTIPLE_RHS
+                const unsigned int ld = D == DMatrix::DISTRIBUTED_SOL_AND_RHS ? _sizeRHS - offset : Solver<K>::_n;
+                const unsigned int n = std::min(_sizeRHS - offset, ld);
+                if(mu * ld > _sizeWork) {
+                    delete [] _work;
+                    _sizeWork = mu * ld;
+                    _work = new K[_sizeWork];
+                }
+                for(unsigned int i = 0; i < n; ++i)
+                    for(unsigned short j = 0; j < mu; ++j)
+                        _work[i + j * ld] = rhs[(offset + i) * mu + j];
+                Solver<K>::template solve<D>(_work, mu);
+                for(unsigned int i = 0; i < n; ++i)
+                    for(unsigned short j = 0; j < mu; ++j)
+                        rhs[(offset + i) * mu + j] = _work[i + j * ld];
+#else
+                if(_sizeRHS > _sizeWork) {
+                    delete [] _work;
+                    _sizeWork = _sizeRHS;
+                    _work = new K[_sizeWork];
+                }
+                for(unsigned short j = 0; j < mu; ++j) {
+                    for(unsigned int i = 0; i < _sizeRHS; ++i)
+                        _work[i] = rhs[i * mu + j];
+                    Solver<K>::template solve<D>(_work + offset);
+                    for(unsigned int i = 0; i < _sizeRHS; ++i)
+                        rhs[i * mu + j] = _work[i];
+                }
+#endif
+            }
+        }
+        /* Function: tune
+         *
+         *  Selects <Parameter::P> and <Parameter::TOPOLOGY> by minimizing a model of the time needed to factorize the coarse operator and to perform coarse corrections.
+         *
+         * Template Parameter:
+         *    U              - True if the distribution of the coarse operator is uniform, false otherwise. */
+        template<unsigned short U, class Operator, class Container>
+        inline void tune(const Operator&, const MPI_Comm&, Container&);
         /* Function: constructionCommunicator
          *
          *  Builds both <Coarse operator::scatterComm> and <DMatrix::communicator>.
@@ -84,7 +148,7 @@ class CoarseOperator : public Solver<K> {
          *    D              - <DMatrix::Distribution> of right-hand sides and solution vectors.
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise. */
         template<bool U, typename Solver<K>::Distribution D, bool excluded>
-        inline void constructionCollective(const unsigned short* = nullptr, unsigned short p = 0, const unsigned short* = nullptr);
+        inline void constructionCollective(const unsigned short* = nullptr, unsigned short p = 0, const int* = nullptr);
         /* Function: constructionMap
          *
          *  Builds the maps <DMatrix::ldistribution> and <DMatrix::idistribution> necessary for sending and receiving distributed right-hand sides or solution vectors.
@@ -113,8 +177,8 @@ class CoarseOperator : public Solver<K> {
          * Template Parameter:
          *    countMasters   - True if the master processes must be taken into consideration, false otherwise. */
         template<bool countMasters>
-        inline void constructionCommunicatorCollective(const unsigned short* const pt, unsigned short size, MPI_Comm& in, MPI_Comm* const out = nullptr) {
-            unsigned short sizeComm = std::count_if(pt, pt + size, [](const unsigned short& nu) { return nu != 0; });
+        inline void constructionCommunicatorCollective(const unsigned short* const pt, int size, MPI_Comm& in, MPI_Comm* const out = nullptr) {
+            int sizeComm = std::count_if(pt, pt + size, [](const unsigned short& nu) { return nu != 0; });
             if(sizeComm != size && in != MPI_COMM_NULL) {
                 MPI_Group oldComm, newComm;
                 MPI_Comm_group(in, &oldComm);
@@ -122,7 +186,7 @@ class CoarseOperator : public Solver<K> {
                     ++sizeComm;
                 int* array = new int[sizeComm];
                 array[0] = 0;
-                for(unsigned short i = 1, j = 1, k = 0; j < sizeComm; ++i) {
+                for(int i = 1, j = 1, k = 0; j < sizeComm; ++i) {
                     if(pt[i] != 0)
                         array[j++] = i - k;
                     else if(countMasters && Solver<K>::_ldistribution[k + 1] == i)
@@ -148,10 +212,11 @@ class CoarseOperator : public Solver<K> {
                 MPI_Comm_dup(in, out);
         }
     public:
-        CoarseOperator() : _gatherComm(MPI_COMM_NULL), _scatterComm(MPI_COMM_NULL), _rankWorld(), _sizeWorld(), _sizeSplit(), _local(), _sizeRHS(), _offset(false) {
+        CoarseOperator() : _gatherComm(MPI_COMM_NULL), _scatterComm(MPI_COMM_NULL), _rankWorld(), _sizeWorld(), _sizeSplit(), _local(), _sizeRHS(), _offset(false), _work(), _sizeWork() {
             static_assert(!(std::is_same<K, std::complex<double>>::value && S == 'S'), "Symmetric complex coarse operators are not supported.");
         }
         ~CoarseOperator() {
+            delete [] _work;
             if(_gatherComm != _scatterComm && _gatherComm != MPI_COMM_NULL)
                 MPI_Comm_free(&_gatherComm);
             if(_scatterComm != MPI_COMM_NULL)
@@ -163,13 +228,22 @@ class CoarseOperator : public Solver<K> {
         inline std::pair<MPI_Request, const K*>* construction(Operator&, const MPI_Comm&, Container&);
         /* Function: callSolver
          *
-         *  Solves a coarse system.
+         *  Solves a coarse system. With multiple right-hand sides, those are stored one coarse degree of freedom after the other, so that they are gathered and scattered using a single collective operation.
          *
-         * Parameter:
-         *    rhs            - Input right-hand side, solution vector is stored in-place. */
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    fuse           - Number of additional scalars to reduce, only with a single right-hand side.
+         *    mu             - Number of right-hand sides. */
         template<bool = false>
-        inline void callSolver(K* const, const int& = 0);
-#if HPDDM_ICOLLECTIVE
+        inline void callSolver(K* const, const int& = 0, const unsigned short& = 1);
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+        /* Function: IcallSolver
+         *
+         *  Solves a coarse system using nonblocking MPI collective operations.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand side, solution vector is stored in-place once both requests have completed.
+         *    rq             - MPI requests to check completion of the gather and of the scatter operations. */
         template<bool = false>
         inline void IcallSolver(K* const, MPI_Request*, const int& = 0);
 #endif
@@ -194,14 +268,15 @@ class CoarseOperator : public Solver<K> {
          *
          * Parameters:
          *    rhs            - Reference to the pointer to reallocate.
-         *    n              - Additional space needed, see also <Coarse operator::sizeRHS>. */
-        inline void reallocateRHS(K*& rhs, const unsigned short& n) const {
+         *    n              - Additional space needed, see also <Coarse operator::sizeRHS>.
+         *    mu             - Number of right-hand sides. */
+        inline void reallocateRHS(K*& rhs, const unsigned short& n, const unsigned short& mu = 1) const {
             if(rhs)
                 delete [] rhs;
             if(Solver<K>::_communicator != MPI_COMM_NULL)
-                rhs = new K[_sizeRHS + _sizeSplit * n];
+                rhs = new K[mu * _sizeRHS + _sizeSplit * n];
             else
-                rhs = new K[_sizeRHS + n];
+                rhs = new K[mu * _sizeRHS + n];
         }
 };
 } // HPDDM
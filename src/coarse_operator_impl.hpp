@@ -90,12 +90,58 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
             std::iota(ps + 1, ps + tmp, offset + 1);
             std::iota(Solver<K>::_ldistribution, Solver<K>::_ldistribution + p, 0);
         }
-        else if(T == 2) {
-            // Here, it is assumed that all subdomains have the same number of coarse degrees of freedom as the rank 0 ! (only true when the distribution is uniform)
-            float area = _sizeWorld *_sizeWorld / (2.0 * p);
+        else if(T == 2 || T == 3) {
+            int* starts = nullptr;
+            int nodes = 0;
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+            if(T == 3) {
+                MPI_Comm node;
+                MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, _rankWorld, MPI_INFO_NULL, &node);
+                int rankNode, sizeNode;
+                MPI_Comm_rank(node, &rankNode);
+                MPI_Comm_size(node, &sizeNode);
+                int first = _rankWorld - rankNode;
+                MPI_Bcast(&first, 1, MPI_INT, 0, node);
+                MPI_Comm_free(&node);
+                int contiguous = (_rankWorld - first == rankNode);
+                MPI_Allreduce(MPI_IN_PLACE, &contiguous, 1, MPI_INT, MPI_LAND, comm);
+                if(contiguous) {
+                    starts = new int[_sizeWorld];
+                    int leader = (rankNode == 0);
+                    MPI_Allgather(&leader, 1, MPI_INT, starts, 1, MPI_INT, comm);
+                    for(int i = 0; i < _sizeWorld; ++i)
+                        if(starts[i])
+                            starts[nodes++] = i;
+                    if(nodes < p) {
+                        delete [] starts;
+                        starts = nullptr;
+                    }
+                }
+                else if(_rankWorld == 0)
+                    std::cout << "WARNING -- the processes of each node are not numbered contiguously, the master processes are not placed according to the topology of the machine" << std::endl;
+            }
+#endif
             *Solver<K>::_ldistribution = 0;
-            for(unsigned short i = 1; i < p; ++i)
-                Solver<K>::_ldistribution[i] = static_cast<int>(_sizeWorld - std::sqrt(std::max(_sizeWorld * _sizeWorld - 2 * _sizeWorld * Solver<K>::_ldistribution[i - 1] - 2 * area + Solver<K>::_ldistribution[i - 1] * Solver<K>::_ldistribution[i - 1], 1.0f)) + 0.5);
+            if(T == 2 || S == 'S') {
+                // Here, it is assumed that all subdomains have the same number of coarse degrees of freedom as the rank 0 ! (only true when the distribution is uniform)
+                float area = _sizeWorld *_sizeWorld / (2.0 * p);
+                for(unsigned short i = 1; i < p; ++i)
+                    Solver<K>::_ldistribution[i] = static_cast<int>(_sizeWorld - std::sqrt(std::max(_sizeWorld * _sizeWorld - 2 * _sizeWorld * Solver<K>::_ldistribution[i - 1] - 2 * area + Solver<K>::_ldistribution[i - 1] * Solver<K>::_ldistribution[i - 1], 1.0f)) + 0.5);
+            }
+            else
+                for(unsigned short i = 1; i < p; ++i)
+                    Solver<K>::_ldistribution[i] = i * (_sizeWorld / p);
+            if(starts) {
+                // each master process is moved to the first process of the closest node, so that split communicators span whole nodes
+                for(unsigned short i = 1, k = 0; i < p; ++i) {
+                    int j = std::lower_bound(starts + k + 1, starts + nodes, Solver<K>::_ldistribution[i]) - starts;
+                    if(j > k + 1 && (j == nodes || Solver<K>::_ldistribution[i] - starts[j - 1] < starts[j] - Solver<K>::_ldistribution[i]))
+                        --j;
+                    k = std::min(j, nodes - p + i);
+                    Solver<K>::_ldistribution[i] = starts[k];
+                }
+                delete [] starts;
+            }
             int* idx = std::upper_bound(Solver<K>::_ldistribution, Solver<K>::_ldistribution + p, _rankWorld);
             unsigned short i = idx - Solver<K>::_ldistribution;
             tmp = (i == p) ? _sizeWorld - Solver<K>::_ldistribution[i - 1] : Solver<K>::_ldistribution[i] - Solver<K>::_ldistribution[i - 1];
@@ -127,7 +173,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
 
 template<template<class> class Solver, char S, class K>
 template<bool U, typename Solver<K>::Distribution D, bool excluded>
-inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned short* info, unsigned short p, const unsigned short* infoSplit) {
+inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned short* info, unsigned short p, const int* infoSplit) {
     if(!U) {
         if(excluded)
             _sizeWorld -= p;
@@ -136,7 +182,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned
 
         Solver<K>::_displs[0] = 0;
         Solver<K>::_gatherCounts[0] = info[0];
-        for(unsigned int i = 1, j = 1; j < _sizeWorld; ++i)
+        for(int i = 1, j = 1; j < _sizeWorld; ++i)
             if(!excluded || info[i] != 0)
                 Solver<K>::_gatherCounts[j++] = info[i];
         std::partial_sum(Solver<K>::_gatherCounts, Solver<K>::_gatherCounts + _sizeWorld - 1, Solver<K>::_displs + 1);
@@ -146,7 +192,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned
             Solver<K>::_gatherSplitCounts = new int[_sizeSplit];
             Solver<K>::_displsSplit = new int[_sizeSplit];
             Solver<K>::_displsSplit[0] = 0;
-            for(unsigned int i = 0; i < _sizeSplit; ++i)
+            for(int i = 0; i < _sizeSplit; ++i)
                 Solver<K>::_gatherSplitCounts[i] = infoSplit[i];
             std::partial_sum(Solver<K>::_gatherSplitCounts, Solver<K>::_gatherSplitCounts + _sizeSplit - 1, Solver<K>::_displsSplit + 1);
         }
@@ -230,13 +276,117 @@ inline void CoarseOperator<Solver, S, K>::constructionMap(unsigned short p, cons
     }
 }
 
+template<template<class> class Solver, char S, class K>
+template<unsigned short U, class Operator, class Container>
+inline void CoarseOperator<Solver, S, K>::tune(const Operator& v, const MPI_Comm& comm, Container& parm) {
+    int size, rank;
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &rank);
+    parm[P] = 1;
+    parm[TOPOLOGY] = 0;
+    if(size < 4 || std::is_same<Solver<K>, SuiteSparse<K>>::value || std::is_same<Solver<K>, DenseLapack<K>>::value)
+        return;
+    // a complex multiply-add costs four times as many floating-point operations as a real one
+    const double scaling = std::is_same<K, typename Wrapper<K>::ul_type>::value ? 1.0 : 4.0;
+    const std::string name[3] = { "tune_flops", "tune_latency", "tune_bandwidth" };
+    if(Option::get().val<bool>("tune_calibrate", true) && !(Option::get().any(name[0]) && Option::get().any(name[1]) && Option::get().any(name[2]))) {
+        double model[3];
+        const int n = 128;
+        K* a = new K[3 * n * n];
+        std::fill(a, a + 2 * n * n, Wrapper<K>::d__1);
+        MPI_Barrier(comm);
+        double timing = MPI_Wtime();
+        for(unsigned short i = 0; i < 4; ++i)
+            Wrapper<K>::gemm(&transa, &transa, &n, &n, &n, &(Wrapper<K>::d__1), a, &n, a + n * n, &n, &(Wrapper<K>::d__0), a + 2 * n * n, &n);
+        model[0] = scaling * 8.0 * n * n * n / std::max(MPI_Wtime() - timing, 1.0e-9);
+        delete [] a;
+        double* buffer = new double[1 << 17]();
+        MPI_Barrier(comm);
+        timing = MPI_Wtime();
+        for(unsigned short i = 0; i < 10; ++i)
+            MPI_Allreduce(MPI_IN_PLACE, buffer, 1, MPI_DOUBLE, MPI_SUM, comm);
+        model[1] = (MPI_Wtime() - timing) / (10.0 * std::ceil(std::log2(size)));
+        MPI_Barrier(comm);
+        timing = MPI_Wtime();
+        for(unsigned short i = 0; i < 4; ++i)
+            MPI_Bcast(buffer, 1 << 17, MPI_DOUBLE, 0, comm);
+        timing = (MPI_Wtime() - timing) / 4.0 - model[1] * std::ceil(std::log2(size));
+        model[2] = (sizeof(double) << 17) / std::max(timing, 1.0e-9);
+        delete [] buffer;
+        MPI_Bcast(model, 3, MPI_DOUBLE, 0, comm);
+        // later constructions reuse the calibrated values, while those set by the user are kept
+        for(unsigned short i = 0; i < 3; ++i)
+            if(!Option::get().any(name[i]))
+                Option::get().set(name[i], model[i]);
+    }
+    const double model[3] = { Option::get().val(name[0], 1.0e9), Option::get().val(name[1], 5.0e-6), Option::get().val(name[2], 1.0e9) };
+    // number of coarse degrees of freedom, and of nonzero entries in the coarse operator assuming that all neighbors have the same number of deflation vectors
+    double dimension[2] = { static_cast<double>(v._local), static_cast<double>(v._local) * v._local * (1 + v.getPattern().size()) };
+    MPI_Allreduce(MPI_IN_PLACE, dimension, 2, MPI_DOUBLE, MPI_SUM, comm);
+    if(dimension[0] < 1.0)
+        return;
+    // nested dissection of the graph of subdomains, whose dimension is guessed from the average number of neighbors, and sizes of the fronts
+    const double nu = dimension[0] / size;
+    const double d = (dimension[1] / (nu * nu * size) - 1.0) > 10.0 ? 3.0 : 2.0;
+    const double front = nu * std::pow(size, (d - 1.0) / d);
+    const unsigned short levels = std::ceil(std::log2(size));
+    double flops = 0.0, entries = S == 'S' ? dimension[1] / 2.0 : dimension[1];
+    for(unsigned short i = 0; i < levels; ++i) {
+        const double f = front * std::pow(2.0, -i * (d - 1.0) / d);
+        flops += std::pow(2.0, i) * f * f * f;
+        entries += std::pow(2.0, i) * f * f * (S == 'S' ? 0.5 : 1.0);
+    }
+    flops *= scaling * (S == 'S' ? 1.0 : 2.0) / 3.0;
+    entries *= scaling;
+    const double iterations = Option::get().val("tune_iterations", 50.0);
+    double best[3] = { std::numeric_limits<double>::max(), 0.0, 0.0 };
+    for(int p = 1; p <= size / 2; ++p) {
+        // gathering of the coarse operator, then factorization with a dense front distributed on a 2D grid of p processes
+        double factorization = flops / (p * model[0]) + model[1] * size / p + sizeof(K) * dimension[1] / (p * model[2]);
+        // triangular solves, gathering of the right-hand sides, and scattering of the solution vectors
+        double solve = 4.0 * entries / (p * model[0]) + 2.0 * model[1] * std::ceil(std::log2(size / p)) + 2.0 * sizeof(K) * dimension[0] / (p * model[2]);
+        if(p > 1) {
+            factorization += model[1] * (front / 64.0) * std::log2(p) + sizeof(K) * front * front / (std::sqrt(p) * model[2]);
+            solve += 2.0 * model[1] * levels * std::log2(p);
+            if(parm[DISTRIBUTION] == Solver<K>::NON_DISTRIBUTED)
+                solve += 2.0 * sizeof(K) * dimension[0] / model[2];
+        }
+        if(factorization + iterations * solve < best[0]) {
+            best[0] = factorization + iterations * solve;
+            best[1] = factorization;
+            best[2] = solve;
+            parm[P] = p;
+        }
+    }
+    if(S == 'S' && U == 1 && parm[P] > 1)
+        parm[TOPOLOGY] = 2;
+    if(rank == 0 && Option::get().val<int>("verbosity", 0) > 0) {
+        const std::ios_base::fmtflags flags = std::cout.flags();
+        std::cout << std::scientific << " --- coarse operator distribution tuned (estimated size: " << static_cast<long long>(dimension[0]) << ", nonzero entries: " << static_cast<long long>(dimension[1]) << ", predicted factorization time: " << best[1] << ", predicted coarse solve time: " << best[2] << ")" << std::endl;
+        std::cout.flags(flags);
+    }
+}
+
 template<template<class> class Solver, char S, class K>
 template<unsigned short U, unsigned short excluded, class Operator, class Container>
 inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construction(Operator& v, const MPI_Comm& comm, Container& parm) {
     static_assert(Solver<K>::_numbering == 'F' || Solver<K>::_numbering == 'C', "Unknown numbering");
     static_assert(S == 'S' || S == 'G', "Unknown symmetry");
     static_assert(Operator::_pattern == 's' || Operator::_pattern == 'c', "Unknown pattern");
-    if(std::is_same<Solver<K>, SuiteSparse<K>>::value)
+    if(parm[P] == 0) {
+        if(excluded == 0)
+            tune<U>(v, comm, parm);
+        else {
+            // the master processes are already set aside by the caller, so P is the number of processes excluded from the domain decomposition
+            int p = (excluded == 2);
+            MPI_Allreduce(MPI_IN_PLACE, &p, 1, MPI_INT, MPI_SUM, comm);
+            parm[P] = p;
+        }
+    }
+#ifdef DLAPACK
+    const int local = _local;
+#endif
+    if(std::is_same<Solver<K>, SuiteSparse<K>>::value || std::is_same<Solver<K>, DenseLapack<K>>::value)
         if(parm[P] != 1) {
             int rank;
             MPI_Comm_rank(comm, &rank);
@@ -249,6 +399,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         case  1: constructionCommunicator<1, (excluded > 0)>(comm, parm[P]); break;
 #endif
         case  2: constructionCommunicator<2, (excluded > 0)>(comm, parm[P]); break;
+        case  3: constructionCommunicator<3, (excluded > 0)>(comm, parm[P]); break;
         default: constructionCommunicator<0, (excluded > 0)>(comm, parm[P]); break;
     }
     if(excluded > 0 && Solver<K>::_communicator != MPI_COMM_NULL) {
@@ -260,20 +411,30 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     if(U == 2 && parm[NU] == 0)
         _offset = true;
     Solver<K>::initialize(parm);
+    std::pair<MPI_Request, const K*>* ret;
     switch(parm[TOPOLOGY]) {
 #ifndef HPDDM_CONTIGUOUS
-        case  1: return constructionMatrix<1, U, excluded>(v, comm, parm[P]);
+        case  1: ret = constructionMatrix<1, U, excluded>(v, comm, parm[P]); break;
 #endif
-        case  2: return constructionMatrix<2, U, excluded>(v, comm, parm[P]);
-        default: return constructionMatrix<0, U, excluded>(v, comm, parm[P]);
+        case  2:
+        case  3: ret = constructionMatrix<2, U, excluded>(v, comm, parm[P]); break;
+        default: ret = constructionMatrix<0, U, excluded>(v, comm, parm[P]); break;
+    }
+#ifdef DLAPACK
+    if(excluded == 0) {
+        const unsigned short replicate = Option::get().val<unsigned short>("replicate", 0);
+        if(replicate)
+            Solver<K>::replicate(comm, local, replicate);
     }
+#endif
+    return ret;
 }
 
 template<template<class> class Solver, char S, class K>
 template<char T, unsigned short U, unsigned short excluded, class Operator>
 inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::constructionMatrix(Operator& v, const MPI_Comm& comm, unsigned short p) {
-    unsigned short info[(U != 1 ? 3 : 1) + HPDDM_MAXCO];
-    const std::vector<unsigned short>& sparsity = v.getPattern();
+    const std::vector<int>& sparsity = v.getPattern();
+    int info[(U != 1 ? 3 : 1) + sparsity.size()];
     info[0] = sparsity.size(); // number of intersections
     int rank;
     MPI_Comm_rank(v._p.getCommunicator(), &rank);
@@ -284,9 +445,9 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     unsigned short* infoNeighbor;
 
     K*     sendMaster;
-    unsigned int size;
-    int* I;
-    int* J;
+    std::size_t size;
+    typename Solver<K>::integer_type* I;
+    typename Solver<K>::integer_type* J;
     K*   C;
 
     if(U != 1) {
@@ -374,27 +535,40 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             std::copy_n(sparsity.cbegin() + first, info[0], info + (U != 1 ? 3 : 1));
         }
     }
-    unsigned short (*infoSplit)[(U != 1 ? 3 : 1) + HPDDM_MAXCO];
-    unsigned int*   offsetIdx;
+    int**           infoSplit;
+    std::size_t*    offsetIdx;
     unsigned short* infoWorld;
 
     unsigned int offset;
 #ifdef HPDDM_CSR_CO
     unsigned int nrow;
 #ifdef HPDDM_LOC2GLOB
-    int* loc2glob;
+    typename Solver<K>::integer_type* loc2glob;
 #endif
 #endif
 
-    if(rankSplit != 0)
-        MPI_Gather(info, (U != 1 ? 3 : 1) + HPDDM_MAXCO, MPI_UNSIGNED_SHORT, NULL, (U != 1 ? 3 : 1) + HPDDM_MAXCO, MPI_UNSIGNED_SHORT, 0, _scatterComm);
+    if(rankSplit != 0) {
+        int length = (U != 1 ? 3 : 1) + info[0];
+        MPI_Gather(&length, 1, MPI_INT, NULL, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+        MPI_Gatherv(info, length, MPI_INT, NULL, NULL, NULL, MPI_DATATYPE_NULL, 0, _scatterComm);
+    }
     else {
         size = 0;
-        infoSplit = new unsigned short[_sizeSplit][(U != 1 ? 3 : 1) + HPDDM_MAXCO];
-        MPI_Gather(info, (U != 1 ? 3 : 1) + HPDDM_MAXCO, MPI_UNSIGNED_SHORT, reinterpret_cast<unsigned short*>(infoSplit), (U != 1 ? 3 : 1) + HPDDM_MAXCO, MPI_UNSIGNED_SHORT, 0, _scatterComm);
+        // lengths of the variable-sized records (the master only sends its header), then the records themselves
+        int* length = new int[2 * _sizeSplit];
+        *length = (U != 1 ? 3 : 1);
+        MPI_Gather(MPI_IN_PLACE, 1, MPI_INT, length, 1, MPI_INT, 0, _scatterComm);
+        length[_sizeSplit] = 0;
+        std::partial_sum(length, length + _sizeSplit - 1, length + _sizeSplit + 1);
+        infoSplit = new int*[_sizeSplit];
+        *infoSplit = new int[length[2 * _sizeSplit - 1] + length[_sizeSplit - 1]];
+        for(int i = 1; i < _sizeSplit; ++i)
+            infoSplit[i] = *infoSplit + length[_sizeSplit + i];
+        MPI_Gatherv(info, *length, MPI_INT, *infoSplit, length, length + _sizeSplit, MPI_INT, 0, _scatterComm);
+        delete [] length;
         if(S == 'S' && Operator::_pattern == 's')
             **infoSplit -= first;
-        offsetIdx = new unsigned int[_sizeSplit - 1];
+        offsetIdx = new std::size_t[_sizeSplit - 1];
         if(U != 1) {
             infoWorld = new unsigned short[_sizeWorld];
             int recvcounts[p];
@@ -409,17 +583,17 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 recvcounts[p - 1] = _sizeWorld - (p - 1) * (_sizeWorld / p);
             }
             std::partial_sum(recvcounts, recvcounts + p - 1, displs + 1);
-            for(unsigned int i = 0; i < _sizeSplit; ++i)
+            for(int i = 0; i < _sizeSplit; ++i)
                 infoWorld[displs[Solver<K>::_rank] + i] = infoSplit[i][1];
 #ifdef HPDDM_CSR_CO
             nrow = std::accumulate(infoWorld + displs[Solver<K>::_rank], infoWorld + displs[Solver<K>::_rank] + _sizeSplit, 0);
-            I = new int[nrow + 1];
+            I = new typename Solver<K>::integer_type[nrow + 1];
             I[0] = (Solver<K>::_numbering == 'F');
 #ifdef HPDDM_LOC2GLOB
 #ifndef HPDDM_CONTIGUOUS
-            loc2glob = new int[nrow];
+            loc2glob = new typename Solver<K>::integer_type[nrow];
 #else
-            loc2glob = new int[2];
+            loc2glob = new typename Solver<K>::integer_type[2];
 #endif
 #endif
 #endif
@@ -437,13 +611,13 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             Solver<K>::_n = std::accumulate(infoWorld + _rankWorld, infoWorld + _sizeWorld, offset);
             if(Solver<K>::_numbering == 'F')
                 ++offset;
-            unsigned short tmp = 0;
+            unsigned int tmp = 0;
             for(unsigned short i = 0; i < info[0]; ++i) {
                 infoNeighbor[i] = infoWorld[sparsity[i]];
                 if(!(S == 'S' && i < first))
                     tmp += infoNeighbor[i];
             }
-            for(unsigned short k = 1; k < _sizeSplit; ++k) {
+            for(int k = 1; k < _sizeSplit; ++k) {
                 offsetIdx[k - 1] = size;
                 size += infoSplit[k][2];
             }
@@ -457,25 +631,25 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             offset = (_rankWorld - (excluded == 2 ? rank : 0)) * _local + (Solver<K>::_numbering == 'F');
 #ifdef HPDDM_CSR_CO
             nrow = (_sizeSplit - (excluded == 2)) * _local;
-            I = new int[nrow + 1];
+            I = new typename Solver<K>::integer_type[nrow + 1];
             I[0] = (Solver<K>::_numbering == 'F');
 #ifdef HPDDM_LOC2GLOB
 #ifndef HPDDM_CONTIGUOUS
-            loc2glob = new int[nrow];
+            loc2glob = new typename Solver<K>::integer_type[nrow];
 #else
-            loc2glob = new int[2];
+            loc2glob = new typename Solver<K>::integer_type[2];
 #endif
 #endif
 #endif
             if(S == 'S') {
-                for(unsigned short i = 1; i < _sizeSplit; ++i) {
+                for(int i = 1; i < _sizeSplit; ++i) {
                     offsetIdx[i - 1] = size * _local * _local + (i - 1) * _local * (_local + 1) / 2;
                     size += infoSplit[i][0];
                 }
                 info[0] -= first;
                 size = (size + info[0]) * _local * _local + _local * (_local + 1) / 2 * (_sizeSplit - (excluded == 2));
             } else {
-                for(unsigned short i = 1; i < _sizeSplit; ++i) {
+                for(int i = 1; i < _sizeSplit; ++i) {
                     offsetIdx[i - 1] = (i - 1 + size) * _local * _local;
                     size += infoSplit[i][0];
                 }
@@ -483,9 +657,9 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             }
         }
 #ifndef HPDDM_CSR_CO
-        I = new int[size];
+        I = new typename Solver<K>::integer_type[size];
 #endif
-        J = new int[size];
+        J = new typename Solver<K>::integer_type[size];
         C = new K[size];
     }
     const vectorNeighbor& M = v._p.getMap();
@@ -539,7 +713,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         v.initialize(n * (U == 1 || info[0] == 0 ? _local : std::max(static_cast<unsigned short>(_local), *std::max_element(infoNeighbor + first, infoNeighbor + sparsity.size()))), work, S != 'S' ? info[0] : first);
         v.template applyToNeighbor<S, U == 1>(sendNeighbor, work, rqSend, infoNeighbor);
         if(S != 'S') {
-            unsigned short before = 0;
+            unsigned int before = 0;
             for(unsigned short j = 0; j < info[0] && sparsity[j] < rank; ++j)
                 before += (U == 1 ? _local : infoNeighbor[j]);
             K* const pt = (rankSplit != 0 ? sendMaster + before : C + before);
@@ -641,12 +815,12 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         delete [] work;
     }
     else {
-        unsigned short rankRelative = (T == 0 || T == 2) ? _rankWorld : p + _rankWorld * ((_sizeWorld / p) - 1) - 1;
+        int rankRelative = (T == 0 || T == 2) ? _rankWorld : p + _rankWorld * ((_sizeWorld / p) - 1) - 1;
         unsigned int* offsetPosition;
         unsigned int idx;
         if(excluded < 2) {
             idx = coefficients * _local + (S == 'S' ? (_local * (_local + 1)) / 2 : 0);
-            for(unsigned short i = 0; i < _sizeSplit - 1; ++i)
+            for(int i = 0; i < _sizeSplit - 1; ++i)
                 offsetIdx[i] += idx;
             if(Operator::_pattern == 's')
                 idx = info[0];
@@ -659,7 +833,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         int* counts = new int[2 * _sizeSplit];
         counts[0] = 0;
         counts[_sizeSplit] = (U == 1 ? (S == 'S' ? _local * infoSplit[0][0] * _local + _local * (_local + 1) / 2 : (_local * infoSplit[0][0] + _local) * _local) : infoSplit[0][2]);
-        for(unsigned short k = 1; k < _sizeSplit; ++k) {
+        for(int k = 1; k < _sizeSplit; ++k) {
             counts[k] = offsetIdx[k - 1];
             counts[_sizeSplit + k] = (U == 1 ? (counts[_sizeSplit + k - 1] + (S == 'S' ? (_local * infoSplit[k][0] * _local + _local * (_local + 1) / 2) : ((_local * infoSplit[k][0] + _local) * _local))) : infoSplit[k][2]);
         }
@@ -668,7 +842,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 #endif
         if(U != 1) {
 #if !HPDDM_ICOLLECTIVE
-            for(unsigned short k = 1; k < _sizeSplit; ++k) {
+            for(int k = 1; k < _sizeSplit; ++k) {
                 if(infoSplit[k][2])
                     MPI_Irecv(C + offsetIdx[k - 1], infoSplit[k][2], Wrapper<K>::mpi_type(), k, 3, _scatterComm, rqRecv + idx + k - 1);
                 else
@@ -678,84 +852,21 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             offsetPosition = new unsigned int[_sizeSplit];
             offsetPosition[0] = std::accumulate(infoWorld, infoWorld + rankRelative, static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
             if(T == 0 || T == 2)
-                for(unsigned int k = 1; k < _sizeSplit; ++k)
+                for(int k = 1; k < _sizeSplit; ++k)
                     offsetPosition[k] = offsetPosition[k - 1] + infoSplit[k - 1][1];
             else if(T == 1)
-                for(unsigned int k = 1; k < _sizeSplit; ++k)
+                for(int k = 1; k < _sizeSplit; ++k)
                     offsetPosition[k] = offsetPosition[k - 1] + infoWorld[rankRelative + k - 1];
         }
 #if !HPDDM_ICOLLECTIVE
         else {
-            for(unsigned short k = 1; k < _sizeSplit; ++k)
+            for(int k = 1; k < _sizeSplit; ++k)
                 MPI_Irecv(C + offsetIdx[k - 1], S == 'S' ? _local * infoSplit[k][0] * _local + _local * (_local + 1) / 2 : (_local * infoSplit[k][0] + _local) * _local, Wrapper<K>::mpi_type(), k, 3, _scatterComm, rqRecv + idx + k - 1);
         }
 #endif
-#pragma omp parallel for shared(I, J, infoWorld, infoSplit, rankRelative, offsetIdx, offsetPosition) schedule(dynamic, 64)
-        for(unsigned int k = 1; k < _sizeSplit; ++k) {
-            if(U == 1 || infoSplit[k][2]) {
-                unsigned int tmp = U == 1 ? (rankRelative + k - (excluded == 2 ? (T == 1 ? p : 1 + rank) : 0)) * _local + (Solver<K>::_numbering == 'F') : offsetPosition[k];
-                unsigned int idxSlave = offsetIdx[k - 1];
-                unsigned int offsetSlave;
-                if(U != 1)
-                    offsetSlave = std::accumulate(infoWorld, infoWorld + infoSplit[k][U != 1 ? 3 : 1], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
-                unsigned short i = 0;
-                if(S != 'S')
-                    for( ; infoSplit[k][(U != 1 ? 3 : 1) + i] < rankRelative + k - (U == 1 && excluded == 2 ? (T == 1 ? p : 1 + rank) : 0) && i < infoSplit[k][0]; ++i) {
-                        if(U != 1) {
-                            if(i > 0)
-                                offsetSlave = std::accumulate(infoWorld + infoSplit[k][U != 1 ? 2 + i : i], infoWorld + infoSplit[k][(U != 1 ? 3 : 1) + i], offsetSlave);
-                        }
-                        else
-                            offsetSlave = infoSplit[k][(U != 1 ? 3 : 1) + i] * _local + (Solver<K>::_numbering == 'F');
-                        for(unsigned int j = offsetSlave; j < offsetSlave + (U == 1 ? _local : infoWorld[infoSplit[k][(U != 1 ? 3 : 1) + i]]); ++j)
-                            J[idxSlave++] = j;
-                    }
-                for(unsigned int j = tmp; j < tmp + (U == 1 ? _local : infoSplit[k][1]); ++j)
-                    J[idxSlave++] = j;
-                for( ; i < infoSplit[k][0]; ++i) {
-                    if(U != 1) {
-                        if(i > 0)
-                            offsetSlave = std::accumulate(infoWorld + infoSplit[k][U != 1 ? 2 + i : i], infoWorld + infoSplit[k][(U != 1 ? 3 : 1) + i], offsetSlave);
-                    }
-                    else
-                        offsetSlave = infoSplit[k][(U != 1 ? 3 : 1) + i] * _local + (Solver<K>::_numbering == 'F');
-                    for(unsigned int j = offsetSlave; j < offsetSlave + (U == 1 ? _local : infoWorld[infoSplit[k][(U != 1 ? 3 : 1) + i]]); ++j)
-                        J[idxSlave++] = j;
-                }
-                int coefficientsSlave = idxSlave - offsetIdx[k - 1];
-#ifndef HPDDM_CSR_CO
-                std::fill(I + offsetIdx[k - 1], I + offsetIdx[k - 1] + coefficientsSlave, tmp);
-#else
-                offsetSlave = U == 1 ? (k - (excluded == 2)) * _local : offsetPosition[k] - offsetPosition[1] + (excluded == 2 ? 0 : _local);
-                I[offsetSlave + 1] = coefficientsSlave;
-#if defined(HPDDM_LOC2GLOB) && !defined(HPDDM_CONTIGUOUS)
-                loc2glob[offsetSlave] = tmp;
-#endif
-#endif
-                for(i = 1; i < (U == 1 ? _local : infoSplit[k][1]); ++i, idxSlave += coefficientsSlave) {
-                    if(S == 'S')
-                        --coefficientsSlave;
-#ifndef HPDDM_CSR_CO
-                    std::fill(I + idxSlave, I + idxSlave + coefficientsSlave, tmp + i);
-#else
-                    I[offsetSlave + 1 + i] = coefficientsSlave;
-#if defined(HPDDM_LOC2GLOB) && !defined(HPDDM_CONTIGUOUS)
-                    loc2glob[offsetSlave + i] = tmp + i;
-#endif
-#endif
-                    std::copy(J + idxSlave - coefficientsSlave, J + idxSlave, J + idxSlave);
-                }
-#if defined(HPDDM_LOC2GLOB) && defined(HPDDM_CONTIGUOUS)
-                if(excluded == 2 && k == 1)
-                    loc2glob[0] = tmp;
-                if(k == _sizeSplit - 1)
-                    loc2glob[1] = tmp + (U == 1 ? _local : infoSplit[k][1]) - 1;
-#endif
-            }
-        }
-        delete [] offsetIdx;
+        unsigned int (*offsetArray)[(Operator::_pattern == 's') + (U != 1)] = nullptr;
         if(excluded < 2) {
-            unsigned int (*offsetArray)[(Operator::_pattern == 's') + (U != 1)] = new unsigned int[info[0]][(Operator::_pattern == 's') + (U != 1)];
+            offsetArray = new unsigned int[info[0]][(Operator::_pattern == 's') + (U != 1)];
 #ifdef HPDDM_CSR_CO
             for(unsigned short k = 0; k < _local; ++k) {
                 I[k + 1] = coefficients + (S == 'S' ? _local - k : 0);
@@ -804,17 +915,97 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 }
                 info[0] = M.size();
             }
-            if(U == 1 || _local)
-                for(unsigned int k = 0; k < info[0]; ++k) {
-                    int index;
-                    MPI_Waitany(info[0], rqRecv, &index, MPI_STATUS_IGNORE);
-                    if(Operator::_pattern == 's')
-                        v.template applyFromNeighborMaster<S, Solver<K>::_numbering, U == 1>(recvNeighbor[index], index + first, I + offsetArray[index][0], J + offsetArray[index][0], C + offsetArray[index][0], coefficients + (S == 'S') * (_local - 1), offset, U == 1 ? nullptr : (offsetArray[index] + 1), work, U == 1 ? nullptr : infoNeighbor + first + index);
-                    else
-                        v.template applyFromNeighborMaster<S, Solver<K>::_numbering, U == 1>(recvNeighbor[index], index, I, J, C, coefficients, offset, U == 1 ? nullptr : *offsetArray, work, U == 1 ? nullptr : infoNeighbor);
+        }
+        const unsigned short neighbors = info[0];
+        // the contributions of the neighbors of the master process are assembled as soon as they are received, while the indices of the slave processes are generated
+        auto drain = [&]() {
+            for(unsigned short k = 0; k < neighbors; ++k) {
+                int index;
+                MPI_Waitany(neighbors, rqRecv, &index, MPI_STATUS_IGNORE);
+                if(Operator::_pattern == 's')
+                    v.template applyFromNeighborMaster<S, Solver<K>::_numbering, U == 1>(recvNeighbor[index], index + first, I + offsetArray[index][0], J + offsetArray[index][0], C + offsetArray[index][0], coefficients + (S == 'S') * (_local - 1), offset, U == 1 ? nullptr : (offsetArray[index] + 1), work, U == 1 ? nullptr : infoNeighbor + first + index);
+                else
+                    v.template applyFromNeighborMaster<S, Solver<K>::_numbering, U == 1>(recvNeighbor[index], index, I, J, C, coefficients, offset, U == 1 ? nullptr : *offsetArray, work, U == 1 ? nullptr : infoNeighbor);
+            }
+        };
+        int level;
+        MPI_Query_thread(&level);
+        const bool pipeline = excluded < 2 && (U == 1 || _local);
+        const bool funneled = level >= MPI_THREAD_FUNNELED;
+#pragma omp parallel shared(I, J, infoWorld, infoSplit, rankRelative, offsetIdx, offsetPosition)
+        {
+            if(pipeline && funneled) {
+#pragma omp master
+                drain();
+            }
+#pragma omp for schedule(dynamic, 64)
+            for(int k = 1; k < _sizeSplit; ++k) {
+                if(U == 1 || infoSplit[k][2]) {
+                    unsigned int tmp = U == 1 ? (rankRelative + k - (excluded == 2 ? (T == 1 ? p : 1 + rank) : 0)) * _local + (Solver<K>::_numbering == 'F') : offsetPosition[k];
+                    std::size_t idxSlave = offsetIdx[k - 1];
+                    unsigned int offsetSlave;
+                    if(U != 1)
+                        offsetSlave = std::accumulate(infoWorld, infoWorld + infoSplit[k][U != 1 ? 3 : 1], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
+                    unsigned short i = 0;
+                    if(S != 'S')
+                        for( ; infoSplit[k][(U != 1 ? 3 : 1) + i] < rankRelative + k - (U == 1 && excluded == 2 ? (T == 1 ? p : 1 + rank) : 0) && i < infoSplit[k][0]; ++i) {
+                            if(U != 1) {
+                                if(i > 0)
+                                    offsetSlave = std::accumulate(infoWorld + infoSplit[k][U != 1 ? 2 + i : i], infoWorld + infoSplit[k][(U != 1 ? 3 : 1) + i], offsetSlave);
+                            }
+                            else
+                                offsetSlave = infoSplit[k][(U != 1 ? 3 : 1) + i] * _local + (Solver<K>::_numbering == 'F');
+                            for(unsigned int j = offsetSlave; j < offsetSlave + (U == 1 ? _local : infoWorld[infoSplit[k][(U != 1 ? 3 : 1) + i]]); ++j)
+                                J[idxSlave++] = j;
+                        }
+                    for(unsigned int j = tmp; j < tmp + (U == 1 ? _local : infoSplit[k][1]); ++j)
+                        J[idxSlave++] = j;
+                    for( ; i < infoSplit[k][0]; ++i) {
+                        if(U != 1) {
+                            if(i > 0)
+                                offsetSlave = std::accumulate(infoWorld + infoSplit[k][U != 1 ? 2 + i : i], infoWorld + infoSplit[k][(U != 1 ? 3 : 1) + i], offsetSlave);
+                        }
+                        else
+                            offsetSlave = infoSplit[k][(U != 1 ? 3 : 1) + i] * _local + (Solver<K>::_numbering == 'F');
+                        for(unsigned int j = offsetSlave; j < offsetSlave + (U == 1 ? _local : infoWorld[infoSplit[k][(U != 1 ? 3 : 1) + i]]); ++j)
+                            J[idxSlave++] = j;
+                    }
+                    int coefficientsSlave = idxSlave - offsetIdx[k - 1];
+#ifndef HPDDM_CSR_CO
+                    std::fill(I + offsetIdx[k - 1], I + offsetIdx[k - 1] + coefficientsSlave, tmp);
+#else
+                    offsetSlave = U == 1 ? (k - (excluded == 2)) * _local : offsetPosition[k] - offsetPosition[1] + (excluded == 2 ? 0 : _local);
+                    I[offsetSlave + 1] = coefficientsSlave;
+#if defined(HPDDM_LOC2GLOB) && !defined(HPDDM_CONTIGUOUS)
+                    loc2glob[offsetSlave] = tmp;
+#endif
+#endif
+                    for(i = 1; i < (U == 1 ? _local : infoSplit[k][1]); ++i, idxSlave += coefficientsSlave) {
+                        if(S == 'S')
+                            --coefficientsSlave;
+#ifndef HPDDM_CSR_CO
+                        std::fill(I + idxSlave, I + idxSlave + coefficientsSlave, tmp + i);
+#else
+                        I[offsetSlave + 1 + i] = coefficientsSlave;
+#if defined(HPDDM_LOC2GLOB) && !defined(HPDDM_CONTIGUOUS)
+                        loc2glob[offsetSlave + i] = tmp + i;
+#endif
+#endif
+                        std::copy(J + idxSlave - coefficientsSlave, J + idxSlave, J + idxSlave);
+                    }
+#if defined(HPDDM_LOC2GLOB) && defined(HPDDM_CONTIGUOUS)
+                    if(excluded == 2 && k == 1)
+                        loc2glob[0] = tmp;
+                    if(k == _sizeSplit - 1)
+                        loc2glob[1] = tmp + (U == 1 ? _local : infoSplit[k][1]) - 1;
+#endif
                 }
-            delete [] offsetArray;
+            }
         }
+        if(pipeline && !funneled)
+            drain();
+        delete [] offsetIdx;
+        delete [] offsetArray;
 #if !HPDDM_ICOLLECTIVE
         MPI_Waitall(_sizeSplit - 1, rqRecv + idx, MPI_STATUSES_IGNORE);
 #else
@@ -834,7 +1025,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             fileName += "excluded_";
         std::ofstream txtE{ fileName + S + "_" + Solver<K>::_numbering + "_" + std::to_string(T) + "_" + std::to_string(Solver<K>::_rank) + ".txt" };
 #ifndef HPDDM_CSR_CO
-        for(unsigned int i = 0; i < size; ++i)
+        for(std::size_t i = 0; i < size; ++i)
             txtE << "(" << std::setw(4) << I[i] << ", " << std::setw(4) << J[i] << ") = " << std::scientific << C[i] << std::endl;
 #else
         unsigned int acc = 0;
@@ -866,7 +1057,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         Solver<K>::template numfact<S>(nrow, I, loc2glob, J, C);
 #endif
 #else
-        Solver<K>::template numfact<S>(size, I, J, C);
+        Solver<K>::template numfact<S>(size, I, J, C, U == 1 ? _local : 0);
 #endif
 
 #ifdef DMKL_PARDISO
@@ -901,7 +1092,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     }
     else {
         unsigned short* pt;
-        unsigned short size;
+        int size;
         switch(Solver<K>::_distribution) {
             case DMatrix::NON_DISTRIBUTED:
                 if(rankSplit != 0)
@@ -914,21 +1105,16 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 pt = new unsigned short[size];
                 if(rankSplit == 0) {
                     std::copy(infoWorld, infoWorld + _sizeWorld, pt);
-                    for(unsigned int i = 0; i < _sizeSplit; ++i)
+                    for(int i = 0; i < _sizeSplit; ++i)
                         pt[_sizeWorld + i] = infoSplit[i][1];
                 }
                 break;
             case DMatrix::DISTRIBUTED_SOL_AND_RHS:
-                unsigned short* infoMaster;
-                if(rankSplit == 0) {
-                    infoMaster = infoSplit[0];
-                    for(unsigned int i = 0; i < _sizeSplit; ++i)
-                        infoMaster[i] = infoSplit[i][1];
-                }
-                else
-                    infoMaster = new unsigned short[_sizeSplit];
-                pt = infoMaster;
                 size = _sizeSplit;
+                pt = new unsigned short[size];
+                if(rankSplit == 0)
+                    for(int i = 0; i < _sizeSplit; ++i)
+                        pt[i] = infoSplit[i][1];
                 break;
         }
         MPI_Bcast(pt, size, MPI_UNSIGNED_SHORT, 0, _scatterComm);
@@ -943,7 +1129,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             constructionCommunicatorCollective<(excluded > 0)>(pt, _sizeWorld, _gatherComm);
             constructionCommunicatorCollective<false>(pt + _sizeWorld, _sizeSplit, _scatterComm);
         }
-        if(rankSplit != 0 || Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL)
+        if(rankSplit != 0 || Solver<K>::_distribution != DMatrix::NON_DISTRIBUTED)
             delete [] pt;
     }
     if(rankSplit == 0) {
@@ -992,14 +1178,15 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                     *Solver<K>::_gatherCounts = _local;
             }
             else {
-                unsigned short* infoMaster = infoSplit[0];
-                for(unsigned int i = 0; i < _sizeSplit; ++i)
+                int* infoMaster = infoSplit[0];
+                for(int i = 0; i < _sizeSplit; ++i)
                     infoMaster[i] = infoSplit[i][1];
                 constructionCollective<false, DMatrix::DISTRIBUTED_SOL, excluded == 2>(infoWorld, p - 1, infoMaster);
             }
         }
         if(U != 1)
             delete [] infoWorld;
+        delete [] *infoSplit;
         delete [] infoSplit;
         if(excluded == 2) {
             if(Solver<K>::_distribution == DMatrix::NON_DISTRIBUTED && _rankWorld == 0)
@@ -1013,58 +1200,72 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
-inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fuse) {
+inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fuse, const unsigned short& mu) {
+#if !defined(DPASTIX) && !defined(DMKL_PARDISO)
+    static_cast<void>(fuse);
+#endif
+#ifdef DLAPACK
+    if(Solver<K>::isReplicated()) {
+        Solver<K>::redundantSolve(rhs, mu);
+        return;
+    }
+#endif
+    MPI_Datatype type = Wrapper<K>::mpi_type();
+    if(mu > 1) {
+        MPI_Type_contiguous(mu, Wrapper<K>::mpi_type(), &type);
+        MPI_Type_commit(&type);
+    }
     if(_scatterComm != MPI_COMM_NULL) {
         if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL) {
             if(Solver<K>::_displs) {
-                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs);
-                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    solveColumns<DMatrix::DISTRIBUTED_SOL>(rhs, 0, mu);
+                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else
-                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
             else {
-                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
-                    MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    solveColumns<DMatrix::DISTRIBUTED_SOL>(rhs, _offset || excluded ? *Solver<K>::_gatherCounts : 0, mu);
+                    MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else
-                    MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
         }
         else if(Solver<K>::_distribution == DMatrix::NON_DISTRIBUTED) {
             if(Solver<K>::_displs) {
-                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL)
-                    Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs);
-                if(_rankWorld == 0)                   MPI_Scatterv(rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _gatherComm);
+                    solveColumns<DMatrix::NON_DISTRIBUTED>(rhs, 0, mu);
+                if(_rankWorld == 0)                   MPI_Scatterv(rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _gatherComm);
             }
             else {
-                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else                                  MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                else                                  MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL)
-                    Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs + (_offset || excluded ? _local : 0));
-                if(_rankWorld == 0)                   MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
-                else                                  MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    solveColumns<DMatrix::NON_DISTRIBUTED>(rhs, _offset || excluded ? _local : 0, mu);
+                if(_rankWorld == 0)                   MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                else                                  MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
         }
         else if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL_AND_RHS) {
             if(Solver<K>::_displs) {
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs);
-                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, 0, _gatherComm);
+                    solveColumns<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, 0, mu);
+                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else {
-                    MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                 }
             } else {
 #if defined(DPASTIX) || defined(DMKL_PARDISO)
@@ -1072,34 +1273,38 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
                     _local += fuse;
                     if(Solver<K>::_communicator != MPI_COMM_NULL) {
                         *Solver<K>::_gatherCounts += fuse;
-                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
+                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
                         unsigned int end    = _sizeSplit * *Solver<K>::_gatherCounts - fuse;
                         K* pt = rhs + *Solver<K>::_gatherCounts - fuse;
-                        for(unsigned int i = 1; i < _sizeSplit; ++i)
+                        for(int i = 1; i < _sizeSplit; ++i)
                             Wrapper<K>::axpy(&fuse, &(Wrapper<K>::d__1), pt + (i - 1) * *Solver<K>::_gatherCounts, &i__1, rhs + end, &i__1);
+#ifdef DPASTIX
                         Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0), fuse);
-                        MPI_Allreduce(MPI_IN_PLACE, rhs + end, fuse, Wrapper<K>::mpi_type(), MPI_SUM, Solver<K>::_communicator);
+#else
+                        Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
+#endif
+                        MPI_Allreduce(MPI_IN_PLACE, rhs + end, fuse, type, MPI_SUM, Solver<K>::_communicator);
                         for(unsigned int i = _sizeSplit - 1; i > 0; --i)
                             std::copy_n(rhs + end, fuse, pt + (i - 1) * *Solver<K>::_gatherCounts);
-                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                         *Solver<K>::_gatherCounts -= fuse;
                     }
                     else {
-                        MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                        MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                     }
                     _local -= fuse;
                 }
                 else {
 #endif // DPASTIX || DMKL_PARDISO
                     if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                        Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
-                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                        solveColumns<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, _offset || excluded ? *Solver<K>::_gatherCounts : 0, mu);
+                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                     }
                     else {
-                        MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                        MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                     }
 #if defined(DPASTIX) || defined(DMKL_PARDISO)
                 }
@@ -1109,17 +1314,29 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
     }
     else if(Solver<K>::_communicator != MPI_COMM_NULL) {
         switch(Solver<K>::_distribution) {
-            case DMatrix::NON_DISTRIBUTED:         Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs); break;
-            case DMatrix::DISTRIBUTED_SOL:         Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs); break;
-            case DMatrix::DISTRIBUTED_SOL_AND_RHS: Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs); break;
+            case DMatrix::NON_DISTRIBUTED:         solveColumns<DMatrix::NON_DISTRIBUTED>(rhs, 0, mu); break;
+            case DMatrix::DISTRIBUTED_SOL:         solveColumns<DMatrix::DISTRIBUTED_SOL>(rhs, 0, mu); break;
+            case DMatrix::DISTRIBUTED_SOL_AND_RHS: solveColumns<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, 0, mu); break;
         }
     }
+    if(mu > 1)
+        MPI_Type_free(&type);
 }
 
-#if HPDDM_ICOLLECTIVE
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
 inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const rhs, MPI_Request* rq, const int& fuse) {
+#if !defined(DPASTIX) && !defined(DMKL_PARDISO)
+    static_cast<void>(fuse);
+#endif
+#ifdef DLAPACK
+    if(Solver<K>::isReplicated()) {
+        Solver<K>::redundantSolve(rhs);
+        rq[0] = rq[1] = MPI_REQUEST_NULL;
+        return;
+    }
+#endif
     if(_scatterComm != MPI_COMM_NULL) {
         if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL) {
             if(Solver<K>::_displs) {
@@ -1189,9 +1406,13 @@ inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const rhs, MPI_Request*
                         MPI_Wait(rq, MPI_STATUS_IGNORE);
                         unsigned int end    = _sizeSplit * *Solver<K>::_gatherCounts - fuse;
                         K* pt = rhs + *Solver<K>::_gatherCounts - fuse;
-                        for(unsigned int i = 1; i < _sizeSplit; ++i)
+                        for(int i = 1; i < _sizeSplit; ++i)
                             Wrapper<K>::axpy(&fuse, &(Wrapper<K>::d__1), pt + (i - 1) * *Solver<K>::_gatherCounts, &i__1, rhs + end, &i__1);
+#ifdef DPASTIX
                         Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0), fuse);
+#else
+                        Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
+#endif
                         MPI_Allreduce(MPI_IN_PLACE, rhs + end, fuse, Wrapper<K>::mpi_type(), MPI_SUM, Solver<K>::_communicator);
                         for(unsigned int i = _sizeSplit - 1; i > 0; --i)
                             std::copy_n(rhs + end, fuse, pt + (i - 1) * *Solver<K>::_gatherCounts);
@@ -1230,6 +1451,6 @@ inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const rhs, MPI_Request*
         }
     }
 }
-#endif // HPDDM_ICOLLECTIVE
+#endif
 } // HPDDM
 #endif // _COARSE_OPERATOR_IMPL_
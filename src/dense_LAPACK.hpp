@@ -0,0 +1,359 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <jolivet@ann.jussieu.fr>
+        Date: 2015-02-02
+
+   Copyright (C) 2011-2014 Université de Grenoble
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DENSE_LAPACK_
+#define _DENSE_LAPACK_
+
+namespace HPDDM {
+template<class K>
+class DenseLapack;
+} // HPDDM
+
+#ifdef DLAPACK
+#define COARSEOPERATOR HPDDM::DenseLapack
+
+namespace HPDDM {
+/* Class: Dense LAPACK
+ *
+ *  A class inheriting from <DMatrix> to assemble small coarse operators as dense matrices, and to factorize them with a Cholesky, a Bunch-Kaufman, or an LU decomposition on a single master process. The factors may be replicated on all processes so that coarse corrections are computed redundantly, see <Dense LAPACK::replicate>.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class DenseLapack : public DMatrix {
+    private:
+        /* Variable: a
+         *  Factors of the coarse operator, stored in column-major order. */
+        K*                    _a;
+        /* Variable: ipiv
+         *  Pivot indices of the Bunch-Kaufman or LU factorization, nullptr if the coarse operator is factorized using a Cholesky decomposition. */
+        int*               _ipiv;
+        /* Variable: type
+         *  'C'holesky, 'B'unch-Kaufman, or 'L'U factorization of <Dense LAPACK::a>. */
+        char               _type;
+        /* Variable: replicated
+         *  Communicator of the processes holding a copy of <Dense LAPACK::a>, MPI_COMM_NULL if the factors are not replicated or are replicated on another process of <Dense LAPACK::node>. */
+        MPI_Comm     _replicated;
+        /* Variable: node
+         *  Communicator of the processes sharing a node, MPI_COMM_NULL if the factors are replicated on all processes. */
+        MPI_Comm           _node;
+        /* Variable: window
+         *  Window of the memory shared by all processes of <Dense LAPACK::node> for storing <Dense LAPACK::a> followed by a right-hand side, MPI_WIN_NULL if the factors are not in shared memory. */
+        MPI_Win          _window;
+        /* Variable: counts
+         *  Number of coarse degrees of freedom of each process of <Dense LAPACK::node> (or <Dense LAPACK::replicated> if <Dense LAPACK::node> is MPI_COMM_NULL), followed by the displacements in the coarse numbering. On processes not holding a copy of <Dense LAPACK::a>, only the local number of coarse degrees of freedom and its displacement. */
+        int*             _counts;
+        /* Variable: work
+         *  Workspace array for redundant solves. */
+        K*                 _work;
+        /* Variable: mu
+         *  Number of right-hand sides that fit in <Dense LAPACK::work>. */
+        unsigned short       _mu;
+        /* Function: solveInterleaved
+         *  Solves the system in-place for right-hand sides stored one coarse degree of freedom after the other, using the second half of <Dense LAPACK::work> to store them one after the other. */
+        inline void solveInterleaved(K* const rhs, const unsigned short& mu) const {
+            if(mu == 1)
+                solve<DMatrix::NON_DISTRIBUTED>(rhs);
+            else {
+                K* const tmp = _work + mu * DMatrix::_n;
+                for(int i = 0; i < DMatrix::_n; ++i)
+                    for(unsigned short j = 0; j < mu; ++j)
+                        tmp[i + j * DMatrix::_n] = rhs[i * mu + j];
+                solve<DMatrix::NON_DISTRIBUTED>(tmp, mu);
+                for(int i = 0; i < DMatrix::_n; ++i)
+                    for(unsigned short j = 0; j < mu; ++j)
+                        rhs[i * mu + j] = tmp[i + j * DMatrix::_n];
+            }
+        }
+    protected:
+        /* Variable: numbering
+         *  0-based indexing. */
+        static constexpr char _numbering = 'C';
+        /* Typedef: integer_type
+         *  Type of the row and column indices. */
+        typedef int integer_type;
+    public:
+        DenseLapack() : _a(), _ipiv(), _type('C'), _replicated(MPI_COMM_NULL), _node(MPI_COMM_NULL), _window(MPI_WIN_NULL), _counts(), _work(), _mu(1) { }
+        ~DenseLapack() {
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+            if(_window != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(_window);
+                MPI_Win_free(&_window);
+            }
+            else
+#endif
+                delete [] _a;
+            delete [] _ipiv;
+            delete [] _counts;
+            delete [] _work;
+            if(_replicated != MPI_COMM_NULL)
+                MPI_Comm_free(&_replicated);
+            if(_node != MPI_COMM_NULL)
+                MPI_Comm_free(&_node);
+        }
+        /* Function: numfact
+         *
+         *  Assembles the supplied matrix in <Dense LAPACK::a>, and factorizes it. A symmetric matrix is first factorized using a Cholesky decomposition, and if it is not positive definite, it is assembled again and factorized using a Bunch-Kaufman decomposition.
+         *
+         * Template Parameter:
+         *    S              - 'S'ymmetric or 'G'eneral factorization.
+         *
+         * Parameters:
+         *    nz             - Number of nonzero entries.
+         *    I              - Array of row indices.
+         *    J              - Array of column indices.
+         *    C              - Array of data. */
+        template<char S>
+        inline void numfact(std::size_t nz, integer_type* I, integer_type* J, K* C, unsigned short = 0) {
+            const std::size_t nn = static_cast<std::size_t>(DMatrix::_n) * DMatrix::_n;
+            _a = new K[nn];
+            auto assemble = [&]() {
+                std::fill_n(_a, nn, K());
+                for(std::size_t k = 0; k < nz; ++k) {
+                    _a[I[k] + static_cast<std::size_t>(J[k]) * DMatrix::_n] += C[k];
+                    if(S == 'S' && I[k] != J[k])
+                        _a[J[k] + static_cast<std::size_t>(I[k]) * DMatrix::_n] += C[k];
+                }
+            };
+            assemble();
+            int info;
+            if(S == 'S') {
+                Wrapper<K>::potrf(&uplo, &(DMatrix::_n), _a, &(DMatrix::_n), &info);
+                if(info > 0) {
+                    assemble();
+                    _type = 'B';
+                    _ipiv = new int[DMatrix::_n];
+                    int lwork = -1;
+                    K wkopt;
+                    Wrapper<K>::sytrf(&uplo, &(DMatrix::_n), _a, &(DMatrix::_n), _ipiv, &wkopt, &lwork, &info);
+                    lwork = std::max(1, static_cast<int>(std::real(wkopt)));
+                    K* const work = new K[lwork];
+                    Wrapper<K>::sytrf(&uplo, &(DMatrix::_n), _a, &(DMatrix::_n), _ipiv, work, &lwork, &info);
+                    delete [] work;
+                }
+            }
+            else {
+                _type = 'L';
+                _ipiv = new int[DMatrix::_n];
+                Wrapper<K>::getrf(&(DMatrix::_n), &(DMatrix::_n), _a, &(DMatrix::_n), _ipiv, &info);
+            }
+            if(info != 0)
+                std::cerr << "BUG LAPACK, INFO = " << info << std::endl;
+            delete [] I;
+            delete [] J;
+        }
+        /* Function: solve
+         *
+         *  Solves the system in-place.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides, stored one after the other. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n = 1) const {
+            int info;
+            const int nrhs = n;
+            if(_type == 'L')
+                Wrapper<K>::getrs(&transa, &(DMatrix::_n), &nrhs, _a, &(DMatrix::_n), _ipiv, rhs, &(DMatrix::_n), &info);
+            else if(_type == 'B')
+                Wrapper<K>::sytrs(&uplo, &(DMatrix::_n), &nrhs, _a, &(DMatrix::_n), _ipiv, rhs, &(DMatrix::_n), &info);
+            else
+                Wrapper<K>::potrs(&uplo, &(DMatrix::_n), &nrhs, _a, &(DMatrix::_n), rhs, &(DMatrix::_n), &info);
+        }
+        /* Function: replicate
+         *
+         *  Broadcasts <Dense LAPACK::a> from the master process to all processes of a communicator, or to a single process per node, so that they may later call <Dense LAPACK::redundantSolve>.
+         *
+         * Parameters:
+         *    comm           - Communicator whose first process is the master process, and where the coarse degrees of freedom are numbered by increasing ranks.
+         *    local          - Local number of coarse degrees of freedom.
+         *    mode           - 1 to replicate the factors on all processes, 2 to replicate them once per node, or 3 to replicate them once per node in memory shared by all processes of the node. */
+        inline void replicate(const MPI_Comm& comm, int local, unsigned short mode = 1) {
+            int rank, size;
+            MPI_Comm_rank(comm, &rank);
+            MPI_Comm_size(comm, &size);
+            int* counts = new int[2 * size];
+            MPI_Allgather(&local, 1, MPI_INT, counts, 1, MPI_INT, comm);
+            counts[size] = 0;
+            std::partial_sum(counts, counts + size - 1, counts + size + 1);
+            int header[2] = { DMatrix::_n, _type };
+            MPI_Bcast(header, 2, MPI_INT, 0, comm);
+            DMatrix::_n = header[0];
+            _type = header[1];
+            const std::size_t nn = static_cast<std::size_t>(DMatrix::_n) * DMatrix::_n;
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+            if(mode > 1)
+                MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &_node);
+#endif
+            if(_node != MPI_COMM_NULL) {
+                int rankNode, sizeNode;
+                MPI_Comm_rank(_node, &rankNode);
+                MPI_Comm_size(_node, &sizeNode);
+                MPI_Comm_split(comm, rankNode == 0 ? 0 : MPI_UNDEFINED, rank, &_replicated);
+                if(rankNode == 0) {
+                    _counts = new int[2 * sizeNode];
+                    MPI_Gather(&rank, 1, MPI_INT, _counts, 1, MPI_INT, 0, _node);
+                    for(int i = sizeNode; i-- > 0; ) {
+                        _counts[sizeNode + i] = counts[size + _counts[i]];
+                        _counts[i] = counts[_counts[i]];
+                    }
+                }
+                else {
+                    _counts = new int[2];
+                    _counts[0] = local;
+                    _counts[1] = counts[size + rank];
+                    MPI_Gather(&rank, 1, MPI_INT, NULL, 0, MPI_DATATYPE_NULL, 0, _node);
+                }
+                delete [] counts;
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                if(mode == 3) {
+                    K* shared;
+                    MPI_Win_allocate_shared(rankNode == 0 ? (nn + DMatrix::_n) * sizeof(K) : 0, sizeof(K), MPI_INFO_NULL, _node, &shared, &_window);
+                    if(rankNode != 0) {
+                        MPI_Aint sizeWindow;
+                        int disp;
+                        MPI_Win_shared_query(_window, 0, &sizeWindow, &disp, &shared);
+                    }
+                    else if(rank == 0) {
+                        std::copy_n(_a, nn, shared);
+                        delete [] _a;
+                    }
+                    _a = shared;
+                    MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+                }
+#endif
+            }
+            else {
+                MPI_Comm_dup(comm, &_replicated);
+                _counts = counts;
+            }
+            if(_replicated != MPI_COMM_NULL) {
+                MPI_Comm_rank(_replicated, &rank);
+                if(rank != 0) {
+                    if(_window == MPI_WIN_NULL)
+                        _a = new K[nn];
+                    if(_type != 'C')
+                        _ipiv = new int[DMatrix::_n];
+                }
+                MPI_Datatype column;
+                MPI_Type_contiguous(DMatrix::_n, Wrapper<K>::mpi_type(), &column);
+                MPI_Type_commit(&column);
+                MPI_Bcast(_a, DMatrix::_n, column, 0, _replicated);
+                MPI_Type_free(&column);
+                if(_type != 'C')
+                    MPI_Bcast(_ipiv, DMatrix::_n, MPI_INT, 0, _replicated);
+                _work = new K[DMatrix::_n];
+            }
+        }
+        /* Function: isReplicated
+         *  Returns true if <Dense LAPACK::replicate> has been called, false otherwise. */
+        inline bool isReplicated() const { return _replicated != MPI_COMM_NULL || _node != MPI_COMM_NULL; }
+        /* Function: redundantSolve
+         *
+         *  Gathers right-hand sides on all processes holding a copy of <Dense LAPACK::a>, and solves the system redundantly. When the factors are replicated once per node, right-hand sides are first gathered on each node, through <Dense LAPACK::window> for a single right-hand side.
+         *
+         * Parameters:
+         *    rhs            - Local part of the input right-hand sides, stored one coarse degree of freedom after the other, local part of the solution vectors is stored in-place.
+         *    mu             - Number of right-hand sides. */
+        inline void redundantSolve(K* const rhs, const unsigned short& mu = 1) {
+            MPI_Datatype type = Wrapper<K>::mpi_type();
+            if(mu > 1) {
+                MPI_Type_contiguous(mu, Wrapper<K>::mpi_type(), &type);
+                MPI_Type_commit(&type);
+                if(_replicated != MPI_COMM_NULL && mu > _mu) {
+                    delete [] _work;
+                    _mu = mu;
+                    _work = new K[2 * _mu * DMatrix::_n];
+                }
+            }
+            if(_node == MPI_COMM_NULL) {
+                int rank, size;
+                MPI_Comm_rank(_replicated, &rank);
+                MPI_Comm_size(_replicated, &size);
+                MPI_Allgatherv(rhs, _counts[rank], type, _work, _counts, _counts + size, type, _replicated);
+                solveInterleaved(_work, mu);
+                std::copy_n(_work + mu * _counts[size + rank], mu * _counts[rank], rhs);
+            }
+            else {
+                int size = 1;
+                if(_replicated != MPI_COMM_NULL)
+                    MPI_Comm_size(_node, &size);
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                if(_window != MPI_WIN_NULL && mu == 1) {
+                    K* const shared = _a + static_cast<std::size_t>(DMatrix::_n) * DMatrix::_n;
+                    std::copy_n(rhs, *_counts, shared + _counts[size]);
+                    MPI_Win_sync(_window);
+                    MPI_Barrier(_node);
+                    MPI_Win_sync(_window);
+                    if(_replicated != MPI_COMM_NULL) {
+                        std::fill_n(_work, DMatrix::_n, K());
+                        for(int i = 0; i < size; ++i)
+                            std::copy_n(shared + _counts[size + i], _counts[i], _work + _counts[size + i]);
+                        MPI_Allreduce(_work, shared, DMatrix::_n, Wrapper<K>::mpi_type(), MPI_SUM, _replicated);
+                        solve<DMatrix::NON_DISTRIBUTED>(shared);
+                    }
+                    MPI_Win_sync(_window);
+                    MPI_Barrier(_node);
+                    MPI_Win_sync(_window);
+                    std::copy_n(shared + _counts[size], *_counts, rhs);
+                    return;
+                }
+#endif
+                if(_replicated != MPI_COMM_NULL) {
+                    std::fill_n(_work, mu * DMatrix::_n, K());
+                    MPI_Gatherv(rhs, *_counts, type, _work, _counts, _counts + size, type, 0, _node);
+                    MPI_Allreduce(MPI_IN_PLACE, _work, mu * DMatrix::_n, Wrapper<K>::mpi_type(), MPI_SUM, _replicated);
+                    solveInterleaved(_work, mu);
+                    MPI_Scatterv(_work, _counts, _counts + size, type, rhs, *_counts, type, 0, _node);
+                }
+                else {
+                    MPI_Gatherv(rhs, *_counts, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _node);
+                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, *_counts, type, 0, _node);
+                }
+            }
+            if(mu > 1)
+                MPI_Type_free(&type);
+        }
+        /* Function: initialize
+         *
+         *  Initializes <DMatrix::rank> and <DMatrix::distribution>.
+         *
+         * Parameter:
+         *    parm           - Vector of parameters. */
+        template<class Container>
+        inline void initialize(Container& parm) {
+            if(DMatrix::_communicator != MPI_COMM_NULL)
+                MPI_Comm_rank(DMatrix::_communicator, &(DMatrix::_rank));
+            if(parm[DISTRIBUTION] != DMatrix::NON_DISTRIBUTED) {
+                if(DMatrix::_communicator != MPI_COMM_NULL && DMatrix::_rank == 0)
+                    std::cout << "WARNING -- only non distributed solution and RHS supported by the dense LAPACK interface, forcing the distribution to NON_DISTRIBUTED" << std::endl;
+                parm[DISTRIBUTION] = DMatrix::NON_DISTRIBUTED;
+            }
+            DMatrix::_distribution = DMatrix::NON_DISTRIBUTED;
+        }
+};
+} // HPDDM
+#endif // DLAPACK
+#endif // _DENSE_LAPACK_
@@ -46,12 +46,12 @@ class DMatrix {
         typedef std::pair<unsigned int, unsigned int>   pair_type;
         /* Typedef: map_type
          *
-         *  std::map of std::vector<T> indexed by unsigned short integers.
+         *  std::map of std::vector<T> indexed by ranks.
          *
          * Template Parameter:
          *    T              - Class. */
         template<class T>
-        using map_type = std::map<unsigned short, std::vector<T>>;
+        using map_type = std::map<int, std::vector<T>>;
         /* Variable: mapRecv
          *  Values that have to be received to match the distribution of the direct solver and of the user. */
         map_type<pair_type>*        _mapRecv;
@@ -111,23 +111,23 @@ class DMatrix {
             std::partial_sum(lsol_loc_glob, lsol_loc_glob + size - 1, disp_lsol_loc_glob + 1);
             MPI_Allgatherv(const_cast<int*>(isol_loc), info, MPI_INT, isol_loc_glob, lsol_loc_glob, disp_lsol_loc_glob, MPI_INT, _communicator);
             delete [] disp_lsol_loc_glob;
-            std::vector<std::pair<unsigned short, unsigned int>> mapping(_n);
-            std::vector<std::pair<unsigned short, unsigned int>> mapping_user(_n);
+            std::vector<std::pair<int, unsigned int>> mapping(_n);
+            std::vector<std::pair<int, unsigned int>> mapping_user(_n);
             _mapRecv = new map_type<pair_type>;
             _mapSend = new map_type<pair_type>;
             _mapOwn = new std::vector<pair_type>;
             unsigned int offset = 0;
-            for(unsigned short z = 0; z < size; ++z)
+            for(int z = 0; z < size; ++z)
                 for(unsigned int w = 0; w < lsol_loc_glob[z]; ++w)
                     mapping[isol_loc_glob[offset++] - 1] = std::make_pair(z, w);
             offset = 0;
             if(_idistribution) {
-                for(unsigned short z = 0; z < size; ++z)
+                for(int z = 0; z < size; ++z)
                     for(unsigned int w = 0; w < _ldistribution[z]; ++w)
                         mapping_user[_idistribution[offset++]] = std::make_pair(z, w);
             }
             else {
-                for(unsigned short z = 0; z < size; ++z)
+                for(int z = 0; z < size; ++z)
                     for(unsigned int w = 0; w < _ldistribution[z]; ++w)
                         mapping_user[offset++] = std::make_pair(z, w);
             }
@@ -136,7 +136,7 @@ class DMatrix {
             offset = std::accumulate(_ldistribution, _ldistribution + _rank, 0);
             if(!isRHS) {
                 for(unsigned int i = 0; i < info; ++i) {
-                    std::pair<unsigned short, unsigned int> tmp = mapping_user[isol_loc[i] - 1];
+                    std::pair<int, unsigned int> tmp = mapping_user[isol_loc[i] - 1];
                     if(tmp.first != _rank) {
                         map_send[tmp.first].emplace_back(sol_loc[i]);
                         (*_mapSend)[tmp.first].emplace_back(i, tmp.second);
@@ -144,7 +144,7 @@ class DMatrix {
                 }
                 if(_idistribution)
                     for(unsigned int x = offset; x < offset + _ldistribution[_rank]; ++x) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[_idistribution[x]];
+                        std::pair<int, unsigned int> tmp = mapping[_idistribution[x]];
                         if(tmp.first != _rank)
                             map_recv[tmp.first].resize(map_recv[tmp.first].size() + 1);
                         else {
@@ -154,7 +154,7 @@ class DMatrix {
                     }
                 else
                     for(unsigned int x = offset; x < offset + _ldistribution[_rank]; ++x) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[x];
+                        std::pair<int, unsigned int> tmp = mapping[x];
                         if(tmp.first != _rank)
                             map_recv[tmp.first].resize(map_recv[tmp.first].size() + 1);
                         else {
@@ -165,13 +165,13 @@ class DMatrix {
             }
             else {
                 for(unsigned int i = 0; i < info; ++i) {
-                    unsigned short tmp = mapping_user[isol_loc[i] - 1].first;
+                    int tmp = mapping_user[isol_loc[i] - 1].first;
                     if(tmp != _rank)
                         map_recv[tmp].resize(map_recv[tmp].size() + 1);
                 }
                 if(_idistribution)
                     for(unsigned int x = offset; x < offset + _ldistribution[_rank]; ++x) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[_idistribution[x]];
+                        std::pair<int, unsigned int> tmp = mapping[_idistribution[x]];
                         if(tmp.first != _rank) {
                             map_send[tmp.first].emplace_back(sol[x - offset]);
                             (*_mapSend)[tmp.first].emplace_back(x - offset, tmp.second);
@@ -183,7 +183,7 @@ class DMatrix {
                     }
                 else
                     for(unsigned int x = offset; x < offset + _ldistribution[_rank]; ++x) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[x];
+                        std::pair<int, unsigned int> tmp = mapping[x];
                         if(tmp.first != _rank) {
                             map_send[tmp.first].emplace_back(sol[x - offset]);
                             (*_mapSend)[tmp.first].emplace_back(x - offset, tmp.second);
@@ -29,8 +29,8 @@ namespace HPDDM {
  *  Parameters for the construction of a distributed matrix.
  *
  *    NU             - Number of eigenvalues on current subdomain.
- *    P              - Number of master processes.
- *    TOPOLOGY       - Distribution of the matrix.
+ *    P              - Number of master processes, or zero to let <Coarse operator::tune> select both P and TOPOLOGY.
+ *    TOPOLOGY       - Distribution of the matrix, 3 to place the master processes on the first process of distinct nodes.
  *    DISTRIBUTION   - Controls whether right-hand sides and solution vectors should be distributed or not.
  *    STRATEGY       - Strategy of the direct solver for the analysis phase.
  *
@@ -0,0 +1,195 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <jolivet@ann.jussieu.fr>
+        Date: 2015-02-09
+
+   Copyright (C) 2011-2014 Université de Grenoble
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HODLR_
+#define _HODLR_
+
+#include <tuple>
+
+namespace HPDDM {
+/* Class: Hodlr
+ *
+ *  A class for storing symmetric matrices in the Hierarchically Off-Diagonal Low-Rank format. The matrix is recursively bisected, diagonal blocks of the finest level are stored as dense matrices, and off-diagonal blocks are approximated using an adaptive cross approximation with partial pivoting.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class Hodlr {
+    private:
+        /* Variable: n
+         *  Number of rows and columns. */
+        int                                              _n;
+        /* Variable: leaves
+         *  Dense diagonal blocks, stored as pairs of offsets and lower triangular parts. */
+        std::vector<std::pair<int, K*>>             _leaves;
+        /* Variable: blocks
+         *  Off-diagonal blocks below the diagonal, stored as tuples of row offsets, column offsets, numbers of rows, numbers of columns, ranks, and factors U and V such that the blocks are approximated by U V^T. A negative rank means that U holds the dense block and that V is not used. */
+        std::vector<std::tuple<int, int, int, int, int, K*, K*>> _blocks;
+        /* Variable: rank
+         *  Maximum rank of all off-diagonal blocks. */
+        int                                           _rank;
+        /* Variable: work
+         *  Workspace array of size <Hodlr::rank>, used by <Hodlr::apply> when no workspace is supplied. */
+        K*                                            _work;
+        /* Function: build
+         *  Recursively bisects the rows and columns between two offsets, and compresses the off-diagonal blocks. */
+        inline void build(const K* const a, const int& lda, int begin, int end, const typename Wrapper<K>::ul_type& eps, const int& leaf) {
+            const int m = end - begin;
+            if(m <= leaf) {
+                K* const d = new K[m * m];
+                Wrapper<K>::lacpy(&uplo, &m, &m, a + begin + begin * lda, &lda, d, &m);
+                _leaves.emplace_back(begin, d);
+            }
+            else {
+                const int mid = begin + m / 2;
+                aca(a, lda, mid, begin, end - mid, mid - begin, eps);
+                build(a, lda, begin, mid, eps, leaf);
+                build(a, lda, mid, end, eps, leaf);
+            }
+        }
+        /* Function: aca
+         *  Computes a low-rank approximation of an off-diagonal block, and falls back to a dense storage when the rank is too large for the approximation to save memory. */
+        inline void aca(const K* const a, const int& lda, int row, int col, int m, int n, const typename Wrapper<K>::ul_type& eps) {
+            const int maxRank = (m * n) / (m + n);
+            std::vector<K> u, v;
+            std::vector<char> used(m);
+            typename Wrapper<K>::ul_type norm = 0.0;
+            int i = 0, r = 0;
+            while(r < maxRank) {
+                used[i] = true;
+                v.resize((r + 1) * n);
+                K* const pv = v.data() + r * n;
+                for(int j = 0; j < n; ++j)
+                    pv[j] = a[row + i + (col + j) * lda];
+                if(r)
+                    Wrapper<K>::gemv(&transa, &n, &r, &(Wrapper<K>::d__2), v.data(), &n, u.data() + i, &m, &(Wrapper<K>::d__1), pv, &i__1);
+                const int j = std::distance(pv, std::max_element(pv, pv + n, [](const K& lhs, const K& rhs) { return std::abs(lhs) < std::abs(rhs); }));
+                if(std::abs(pv[j]) < HPDDM_EPS) {
+                    v.resize(r * n);
+                    i = std::distance(used.cbegin(), std::find(used.cbegin(), used.cend(), false));
+                    if(i == m)
+                        break;
+                    continue;
+                }
+                const K pivot = K(1.0) / pv[j];
+                Wrapper<K>::scal(&n, &pivot, pv, &i__1);
+                u.resize((r + 1) * m);
+                K* const pu = u.data() + r * m;
+                for(int k = 0; k < m; ++k)
+                    pu[k] = a[row + k + (col + j) * lda];
+                if(r)
+                    Wrapper<K>::gemv(&transa, &m, &r, &(Wrapper<K>::d__2), u.data(), &m, v.data() + j, &n, &(Wrapper<K>::d__1), pu, &i__1);
+                const typename Wrapper<K>::ul_type contribution = Wrapper<K>::nrm2(&m, pu, &i__1) * Wrapper<K>::nrm2(&n, pv, &i__1);
+                norm += contribution * contribution;
+                ++r;
+                if(contribution <= eps * std::sqrt(norm))
+                    break;
+                i = -1;
+                for(int k = 0; k < m; ++k)
+                    if(!used[k] && (i == -1 || std::abs(pu[k]) > std::abs(pu[i])))
+                        i = k;
+                if(i == -1)
+                    break;
+            }
+            if(r >= maxRank) {
+                K* const d = new K[m * n];
+                Wrapper<K>::lacpy("A", &m, &n, a + row + col * lda, &lda, d, &m);
+                _blocks.emplace_back(row, col, m, n, -1, d, nullptr);
+            }
+            else if(r > 0) {
+                K* const pu = new K[r * (m + n)];
+                std::copy_n(u.cbegin(), r * m, pu);
+                std::copy_n(v.cbegin(), r * n, pu + r * m);
+                _blocks.emplace_back(row, col, m, n, r, pu, pu + r * m);
+                _rank = std::max(_rank, r);
+            }
+        }
+    public:
+        /* Function: Hodlr
+         *
+         *  Builds the compressed representation of a dense symmetric matrix.
+         *
+         * Parameters:
+         *    a              - Lower triangular part of the matrix, stored column-major.
+         *    n              - Number of rows and columns.
+         *    eps            - Relative accuracy of the low-rank approximations.
+         *    leaf           - Maximum size of the dense diagonal blocks. */
+        Hodlr(const K* const a, const int& n, const typename Wrapper<K>::ul_type& eps, const int& leaf) : _n(n), _rank() {
+            build(a, n, 0, n, eps, std::max(leaf, 1));
+            _work = new K[_rank];
+        }
+        Hodlr(const Hodlr&) = delete;
+        ~Hodlr() {
+            for(const std::pair<int, K*>& p : _leaves)
+                delete [] p.second;
+            for(const std::tuple<int, int, int, int, int, K*, K*>& b : _blocks)
+                delete [] std::get<5>(b);
+            delete [] _work;
+        }
+        /* Function: getMaxRank
+         *  Returns the value of <Hodlr::rank>. */
+        inline int getMaxRank() const { return _rank; }
+        /* Function: getSize
+         *  Returns the number of stored scalars. */
+        inline std::size_t getSize() const {
+            std::size_t size = 0;
+            for(unsigned int i = 0; i < _leaves.size(); ++i) {
+                const std::size_t m = (i + 1 < _leaves.size() ? _leaves[i + 1].first : _n) - _leaves[i].first;
+                size += m * m;
+            }
+            for(const std::tuple<int, int, int, int, int, K*, K*>& b : _blocks)
+                size += std::get<4>(b) < 0 ? std::get<2>(b) * std::get<3>(b) : std::get<4>(b) * (std::get<2>(b) + std::get<3>(b));
+            return size;
+        }
+        /* Function: apply
+         *
+         *  Applies the matrix to multiple right-hand sides.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors.
+         *    work           - Workspace array of size <Hodlr::getMaxRank> times mu (optional if mu is equal to one, <Hodlr::work> is then used). */
+        inline void apply(const K* const in, K* const out, const int& mu, K* work = nullptr) const {
+            if(!work)
+                work = _work;
+            for(unsigned int i = 0; i < _leaves.size(); ++i) {
+                const int m = (i + 1 < _leaves.size() ? _leaves[i + 1].first : _n) - _leaves[i].first;
+                Wrapper<K>::symm(&uplo, &uplo, &m, &mu, &(Wrapper<K>::d__1), _leaves[i].second, &m, in + _leaves[i].first, &_n, &(Wrapper<K>::d__0), out + _leaves[i].first, &_n);
+            }
+            for(const std::tuple<int, int, int, int, int, K*, K*>& b : _blocks) {
+                const int row = std::get<0>(b), col = std::get<1>(b), m = std::get<2>(b), n = std::get<3>(b), r = std::get<4>(b);
+                if(r < 0) {
+                    Wrapper<K>::gemm(&transa, &transa, &m, &mu, &n, &(Wrapper<K>::d__1), std::get<5>(b), &m, in + col, &_n, &(Wrapper<K>::d__1), out + row, &_n);
+                    Wrapper<K>::gemm(&transb, &transa, &n, &mu, &m, &(Wrapper<K>::d__1), std::get<5>(b), &m, in + row, &_n, &(Wrapper<K>::d__1), out + col, &_n);
+                }
+                else {
+                    Wrapper<K>::gemm(&transb, &transa, &r, &mu, &n, &(Wrapper<K>::d__1), std::get<6>(b), &n, in + col, &_n, &(Wrapper<K>::d__0), work, &r);
+                    Wrapper<K>::gemm(&transa, &transa, &m, &mu, &r, &(Wrapper<K>::d__1), std::get<5>(b), &m, work, &r, &(Wrapper<K>::d__1), out + row, &_n);
+                    Wrapper<K>::gemm(&transb, &transa, &r, &mu, &m, &(Wrapper<K>::d__1), std::get<5>(b), &m, in + row, &_n, &(Wrapper<K>::d__0), work, &r);
+                    Wrapper<K>::gemm(&transa, &transa, &n, &mu, &r, &(Wrapper<K>::d__1), std::get<6>(b), &n, work, &r, &(Wrapper<K>::d__1), out + col, &_n);
+                }
+            }
+        }
+};
+} // HPDDM
+#endif // _HODLR_
@@ -112,6 +112,14 @@ class IterativeMethod {
             else
                 Wrapper<T>::diagv(n, d, in);
         }
+        template<class T, typename std::enable_if<std::is_pointer<T>::value>::type* = nullptr>
+        static inline T flat(T* const pt) {
+            return *pt;
+        }
+        template<class T, typename std::enable_if<!std::is_pointer<T>::value>::type* = nullptr>
+        static inline T* flat(T* const pt) {
+            return pt;
+        }
     public:
         /* Function: GMRES
          *
@@ -135,6 +143,7 @@ class IterativeMethod {
         static inline int GMRES(const Operator& A, K* const x, const K* const b,
                                 const unsigned short m, unsigned short& it, typename Wrapper<K>::ul_type tol,
                                 const MPI_Comm& comm, unsigned short verbosity) {
+            verbosity = Option::get().val("verbosity", verbosity);
             const int n = excluded ? 0 : A.getDof();
             K* const storage = new K[3 * (m + 1) + 2 * n];
             K* s = storage;
@@ -367,6 +376,7 @@ class IterativeMethod {
         static inline int CG(Operator& A, K* const x, const K* const b,
                              unsigned short& it, typename Wrapper<K>::ul_type tol,
                              const MPI_Comm& comm, unsigned short verbosity) {
+            verbosity = Option::get().val("verbosity", verbosity);
             const int n = A.getDof();
             typename Wrapper<K>::ul_type* dir;
             K* p;
@@ -458,6 +468,7 @@ class IterativeMethod {
         static inline int PCG(Operator& A, K* const x, const K* const f,
                               unsigned short& it, typename Wrapper<K>::ul_type tol,
                               const MPI_Comm& comm, unsigned short verbosity) {
+            verbosity = Option::get().val("verbosity", verbosity);
             typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
             const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
             const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
@@ -572,6 +583,180 @@ class IterativeMethod {
             clean(storage[0]);
             return 0;
         }
+        /* Function: PCG
+         *
+         *  Implements the projected CG method for multiple right-hand sides. The iterations for all right-hand sides are performed in lockstep, so that the global operator, the preconditioner, and the coarse corrections are applied to all right-hand sides at once, and that all dot products of an iteration are reduced together. Right-hand sides are deflated once they have converged.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vectors.
+         *    f              - Right-hand sides.
+         *    mu             - Number of right-hand sides.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<bool excluded = false, class Operator, class K>
+        static inline int PCG(Operator& A, K* const x, const K* const f, const unsigned short& mu,
+                              unsigned short& it, typename Wrapper<K>::ul_type tol,
+                              const MPI_Comm& comm, unsigned short verbosity) {
+            verbosity = Option::get().val("verbosity", verbosity);
+            typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
+            const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
+            const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
+            A.allocateBlock(mu);
+            ptr_type storage[std::is_same<ptr_type, K*>::value ? 1 : 2];
+            // storage[0] = r
+            // storage[1] = lambda
+            A.allocateArray(storage, mu);
+            const typename Wrapper<K>::ul_type* const m = flat(A.getScaling());
+            if(std::is_same<ptr_type, K*>::value)
+                A.template start<excluded>(x + offset, f, nullptr, storage[0], mu);
+            else
+                A.template start<excluded>(x, f, storage[1], storage[0], mu);
+            K* const sol = std::is_same<ptr_type, K*>::value ? x + offset : flat(storage[1]);
+            const int ld = std::is_same<ptr_type, K*>::value ? offset + n : n;
+
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+            std::vector<ptr_type> z;
+            z.reserve(it);
+            ptr_type zCurr;
+            A.allocateSingle(zCurr, mu);
+            z.emplace_back(zCurr);
+            if(!excluded)
+                A.precond(storage[0], zCurr, mu);                                                          //     z_0 = M r_0
+
+            typename Wrapper<K>::ul_type* const res = new typename Wrapper<K>::ul_type[2 * mu];
+            A.template computeDot<excluded>(res, zCurr, zCurr, comm, mu);
+            std::vector<char> converged(mu);
+            for(unsigned short j = 0; j < mu; ++j) {
+                res[j] = std::sqrt(res[j]);
+                converged[j] = (res[j] == 0.0);
+            }
+
+            std::vector<ptr_type> p;
+            p.reserve(it);
+            ptr_type pCurr;
+            A.allocateSingle(pCurr, mu);
+            p.emplace_back(pCurr);
+
+            K* const alpha = new K[2 * (it + 1) * mu];
+            K* const beta = alpha + it * mu;
+            // alpha[k * mu + j]        = < z_k, p_k > of the j-th right-hand side
+            //  beta[k * mu + j]        = < z_k, p_i > of the j-th right-hand side
+            //  beta[it * mu + j]        = < z_i, p_i > of the j-th right-hand side
+            //  beta[(it + 1) * mu + j]  = < r_i, p_i > of the j-th right-hand side
+            unsigned short i = 0;
+            typename Wrapper<K>::ul_type resRel = std::numeric_limits<typename Wrapper<K>::ul_type>::max();
+            while(i++ < it) {
+                if(!excluded) {
+                    A.template project<excluded, 'N'>(zCurr, pCurr, mu);                                   //     p_i = P z_i
+                    K* const pt = flat(pCurr);
+                    for(unsigned short j = 0; j < mu; ++j)
+                        if(converged[j])
+                            std::fill_n(pt + j * n, n, K());
+                    for(unsigned short k = 0; k < i - 1; ++k)
+                        for(unsigned short j = 0; j < mu; ++j)
+                            beta[k * mu + j] = converged[j] ? K() : Wrapper<K>::dot(&n, flat(z[k]) + j * n, &i__1, pt + j * n, &i__1);
+                    MPI_Allreduce(MPI_IN_PLACE, beta, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
+                    for(unsigned short k = 0; k < i - 1; ++k)
+                        for(unsigned short j = 0; j < mu; ++j)
+                            if(!converged[j]) {
+                                beta[k * mu + j] /= -alpha[k * mu + j];
+                                Wrapper<K>::axpy(&n, beta + k * mu + j, flat(p[k]) + j * n, &i__1, pt + j * n, &i__1); // p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
+                            }
+                    A.apply(pCurr, zCurr, mu);                                                             //     z_i = F p_i
+
+                    A.allocateSingle(zCurr, mu);
+                    K* const zt = flat(z.back());
+                    K* const rt = flat(storage[0]);
+                    for(unsigned short j = 0; j < mu; ++j) {
+                        if(converged[j])
+                            beta[it * mu + j] = beta[(it + 1) * mu + j] = K();
+                        else {
+                            K* const v = std::is_same<ptr_type, K*>::value ? flat(zCurr) + j * n : pt + j * n;
+                            if(std::is_same<ptr_type, K*>::value)
+                                Wrapper<K>::diagv(n, m, pt + j * n, v);
+                            beta[it * mu + j]       = Wrapper<K>::dot(&n, zt + j * n, &i__1, v, &i__1);
+                            beta[(it + 1) * mu + j] = Wrapper<K>::dot(&n, rt + j * n, &i__1, v, &i__1);
+                        }
+                    }
+                    MPI_Allreduce(MPI_IN_PLACE, beta + it * mu, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    std::copy_n(beta + it * mu, mu, alpha + (i - 1) * mu);
+                    for(unsigned short j = 0; j < mu; ++j) {
+                        if(!converged[j]) {
+                            K gamma = beta[(it + 1) * mu + j] / alpha[(i - 1) * mu + j];
+                            Wrapper<K>::axpy(&n, &gamma, pt + j * n, &i__1, sol + j * ld, &i__1); // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
+                            gamma = -gamma;
+                            Wrapper<K>::axpy(&n, &gamma, zt + j * n, &i__1, rt + j * n, &i__1);  // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
+                        }
+                    }
+                    A.template project<excluded, 'T'>(storage[0], nullptr, mu);                            // r_i + 1 = P^T r_i + 1
+
+                    z.emplace_back(zCurr);
+                    A.precond(storage[0], zCurr, mu);                                                      // z_i + 1 = M r_i
+                }
+                else {
+                    A.template project<excluded, 'N'>(zCurr, pCurr, mu);
+                    std::fill(beta, beta + (it + 2) * mu, K());
+                    MPI_Allreduce(MPI_IN_PLACE, beta, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    MPI_Allreduce(MPI_IN_PLACE, beta + it * mu, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    A.template project<excluded, 'T'>(storage[0], nullptr, mu);
+                }
+                A.template computeDot<excluded>(res + mu, zCurr, zCurr, comm, mu);
+                resRel = 0.0;
+                unsigned short remaining = 0;
+                for(unsigned short j = 0; j < mu; ++j) {
+                    if(!converged[j]) {
+                        res[mu + j] = std::sqrt(res[mu + j]) / res[j];
+                        resRel = std::max(resRel, res[mu + j]);
+                        if(res[mu + j] <= tol)
+                            converged[j] = true;
+                        else
+                            ++remaining;
+                    }
+                }
+                if(verbosity)
+                    std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << resRel << " < " << tol << " (" << mu - remaining << "/" << mu << " converged)" << std::endl;
+                if(remaining == 0) {
+                    it = i;
+                    break;
+                }
+                if(!excluded) {
+                    A.allocateSingle(pCurr, mu);
+                    p.emplace_back(pCurr);
+                    if(std::is_same<ptr_type, K*>::value)
+                        for(unsigned short j = 0; j < mu; ++j)
+                            Wrapper<K>::diagv(n, m, flat(z[i - 1]) + j * n);
+                }
+            }
+            if(verbosity) {
+                if(resRel <= tol)
+                    std::cout << "CG converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "CG does not converges after " << i - 1 << " iteration" << (i > 2 ? "s" : "") << std::endl;
+            }
+            if(std::is_same<ptr_type, K*>::value)
+                A.template computeSolution<excluded>(x, f, mu);
+            else
+                A.template computeSolution<excluded>(x, storage[1], mu);
+            delete [] alpha;
+            delete [] res;
+            for(auto zCurr : z)
+                clean(zCurr);
+            for(auto pCurr : p)
+                clean(pCurr);
+            clean(storage[0]);
+            return 0;
+        }
 };
 } // HPDDM
 #endif // _ITERATIVE_
@@ -33,8 +33,9 @@ namespace HPDDM {
  *
  * Template Parameters:
  *    K              - Scalar type.
- *    N              - 0- or 1-based indexing. */
-template<class K, char N = 'C'>
+ *    N              - 0- or 1-based indexing.
+ *    I              - Integer type of the row pointers, of the column indices, and of the number of nonzero entries. */
+template<class K, char N = 'C', class I = int>
 class MatrixCSR {
     static_assert(N == 'F' || N == 'C', "Unknown numbering");
     private:
@@ -47,10 +48,10 @@ class MatrixCSR {
         K*      _a;
         /* Variable: ia
          *  Array of row pointers. */
-        int*   _ia;
+        I*     _ia;
         /* Variable: ja
          *  Array of column indices. */
-        int*   _ja;
+        I*     _ja;
         /* Variable: n
          *  Number of rows. */
         int     _n;
@@ -59,14 +60,14 @@ class MatrixCSR {
         int     _m;
         /* Variable: nnz
          *  Number of nonzero entries. */
-        int   _nnz;
+        I     _nnz;
         /* Variable: sym
          *  Symmetry of the matrix. */
         bool  _sym;
         MatrixCSR() : _free(true), _a(), _ia(), _ja(), _n(0), _m(0), _nnz(0), _sym(true) { }
-        MatrixCSR(const int& n, const int& m, const bool& sym) : _free(true), _a(), _ia(new int[n + 1]), _ja(), _n(n), _m(m), _nnz(0),  _sym(sym) { }
-        MatrixCSR(const int& n, const int& m, const int& nnz, const bool& sym) : _free(true), _a(new K[nnz]), _ia(new int[n + 1]), _ja(new int[nnz]), _n(n), _m(m), _nnz(nnz), _sym(sym) { }
-        MatrixCSR(const int& n, const int& m, const int& nnz, K* const& a, int* const& ia, int* const& ja, const bool& sym, const bool& takeOwnership = false) : _free(takeOwnership), _a(a), _ia(ia), _ja(ja), _n(n), _m(m), _nnz(nnz), _sym(sym) { }
+        MatrixCSR(const int& n, const int& m, const bool& sym) : _free(true), _a(), _ia(new I[n + 1]), _ja(), _n(n), _m(m), _nnz(0),  _sym(sym) { }
+        MatrixCSR(const int& n, const int& m, const I& nnz, const bool& sym) : _free(true), _a(new K[nnz]), _ia(new I[n + 1]), _ja(new I[nnz]), _n(n), _m(m), _nnz(nnz), _sym(sym) { }
+        MatrixCSR(const int& n, const int& m, const I& nnz, K* const& a, I* const& ia, I* const& ja, const bool& sym, const bool& takeOwnership = false) : _free(takeOwnership), _a(a), _ia(ia), _ja(ja), _n(n), _m(m), _nnz(nnz), _sym(sym) { }
         ~MatrixCSR() {
             if(_free) {
                 delete [] _a;
@@ -80,7 +81,7 @@ class MatrixCSR {
          *
          * Parameter:
          *    A              - Input matrix. */
-        inline bool sameSparsity(MatrixCSR<K>* const& A) const {
+        inline bool sameSparsity(MatrixCSR<K, N, I>* const& A) const {
             if(A->_sym == _sym && A->_nnz >= _nnz) {
                 if(A->_ia == _ia && A->_ja == _ja)
                     return true;
@@ -88,7 +89,7 @@ class MatrixCSR {
                     bool same = true;
                     K* a = new K[_nnz];
                     for(int i = 0; i < _n && same; ++i) {
-                        for(int j = A->_ia[i], k = _ia[i]; j < A->_ia[i + 1]; ++j) {
+                        for(I j = A->_ia[i], k = _ia[i]; j < A->_ia[i + 1]; ++j) {
                             while(k < _ia[i + 1] && _ja[k] < A->_ja[j])
                                 a[k++] = K();
                             if(_ja[k] != A->_ja[j]) {
@@ -123,10 +124,10 @@ class MatrixCSR {
             f << "# First line: n m (is symmetric) nnz indexing" << std::endl;
             f << "# For each nonzero coefficient: i j a_ij such that (i, j) \\in  {1, ..., n} x {1, ..., m}" << std::endl;
             f << _n << " " << _m << " " << _sym << "  " << _nnz << " " << N << std::endl;
-            unsigned int k = _ia[0] - (N == 'F');
+            I k = _ia[0] - (N == 'F');
             int old = f.precision();
-            for(unsigned int i = 0; i < _n; ++i) {
-                unsigned int ke = _ia[i + 1] - (N == 'F');
+            for(int i = 0; i < _n; ++i) {
+                I ke = _ia[i + 1] - (N == 'F');
                 for( ; k < ke; ++k)
                     f << std::setw(9) << i + 1 << " " << std::setw(9) << _ja[k] + (N == 'C') << " " << std::setprecision(20) << _a[k] << std::endl;
             }
@@ -35,59 +35,69 @@ class OperatorBase {
         const Preconditioner&                               _p;
         K** const                                   _deflation;
         const vectorNeighbor&                             _map;
-        std::vector<unsigned short>                  _sparsity;
-        std::vector<std::vector<unsigned short>>  _vecSparsity;
+        std::vector<int>                             _sparsity;
+        std::vector<std::vector<int>>             _vecSparsity;
         const int                                           _n;
         const int                                       _local;
     public:
         static constexpr char                     _pattern = P;
-        inline const std::vector<unsigned short>& getPattern() const { return _sparsity; }
+        inline const std::vector<int>& getPattern() const { return _sparsity; }
         OperatorBase(const Preconditioner& p, const unsigned short& nu) : _p(p), _deflation(p.getVectors()), _map(p.getMap()), _sparsity(), _n(p.getDof()), _local(nu) {
             static_assert(P == 's', "Unsupported constructor with such a sparsity pattern");
             _sparsity.reserve(_map.size());
             for(const pairNeighbor& neighbor : _map)
                 _sparsity.emplace_back(neighbor.first);
         }
-        OperatorBase(const Preconditioner& p, const unsigned short& nu, const unsigned short& relative) : _p(p), _deflation(p.getVectors()), _map(p.getMap()), _sparsity(), _n(p.getDof()), _local(nu) {
+        OperatorBase(const Preconditioner& p, const unsigned short& nu, const int& relative) : _p(p), _deflation(p.getVectors()), _map(p.getMap()), _sparsity(), _n(p.getDof()), _local(nu) {
             static_assert(P == 'c', "Unsupported constructor with such a sparsity pattern");
 
             if(!_map.empty()) {
                 _vecSparsity.resize(_map.size());
-                unsigned short** recvSparsity = new unsigned short*[_map.size() + 1];
-                *recvSparsity = new unsigned short[(HPDDM_MAXCO + 1) * _map.size()];
-                unsigned short* sendSparsity = *recvSparsity + HPDDM_MAXCO * _map.size();
+                unsigned short* sizes = new unsigned short[_map.size() + 1];
+                sizes[_map.size()] = _map.size();
                 MPI_Request* rq = new MPI_Request[2 * _map.size()];
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    MPI_Irecv(sizes + i, 1, MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + i);
+                    MPI_Isend(sizes + _map.size(), 1, MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + _map.size() + i);
+                }
+                MPI_Waitall(_map.size(), rq, MPI_STATUSES_IGNORE);
+                unsigned int accumulate = _map.size();
+                for(unsigned short i = 0; i < _map.size(); ++i)
+                    accumulate += sizes[i];
+                int** recvSparsity = new int*[_map.size() + 1];
+                *recvSparsity = new int[accumulate];
+                int* sendSparsity = *recvSparsity + accumulate - _map.size();
+                MPI_Waitall(_map.size(), rq + _map.size(), MPI_STATUSES_IGNORE);
                 for(unsigned short i = 0; i < _map.size(); ++i) {
                     sendSparsity[i] = _map[i].first;
-                    recvSparsity[i] = *recvSparsity + HPDDM_MAXCO * i;
-                    MPI_Irecv(recvSparsity[i], HPDDM_MAXCO, MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + i);
+                    if(i > 0)
+                        recvSparsity[i] = recvSparsity[i - 1] + sizes[i - 1];
+                    MPI_Irecv(recvSparsity[i], sizes[i], MPI_INT, _map[i].first, 5, _p.getCommunicator(), rq + i);
                 }
                 for(unsigned short i = 0; i < _map.size(); ++i)
-                    MPI_Isend(sendSparsity, _map.size(), MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + _map.size() + i);
+                    MPI_Isend(sendSparsity, _map.size(), MPI_INT, _map[i].first, 5, _p.getCommunicator(), rq + _map.size() + i);
                 for(unsigned short i = 0; i < _map.size(); ++i) {
-                    int index, count;
-                    MPI_Status status;
-                    MPI_Waitany(_map.size(), rq, &index, &status);
-                    MPI_Get_count(&status, MPI_UNSIGNED_SHORT, &count);
-                    _vecSparsity[index].resize(count);
-                    std::copy(recvSparsity[index], recvSparsity[index] + count, _vecSparsity[index].begin());
+                    int index;
+                    MPI_Waitany(_map.size(), rq, &index, MPI_STATUS_IGNORE);
+                    _vecSparsity[index].assign(recvSparsity[index], recvSparsity[index] + sizes[index]);
                 }
                 MPI_Waitall(_map.size(), rq + _map.size(), MPI_STATUSES_IGNORE);
 
                 delete [] *recvSparsity;
                 delete [] recvSparsity;
+                delete [] sizes;
                 delete [] rq;
 
                 _sparsity.reserve(_map.size());
-                std::vector<unsigned short> neighbors;
+                std::vector<int> neighbors;
                 neighbors.reserve(_map.size());
                 for(const pairNeighbor& neighbor : _map)
                     neighbors.emplace_back(neighbor.first);
-                typedef std::pair<std::vector<unsigned short>::const_iterator, std::vector<unsigned short>::const_iterator> pairIt;
+                typedef std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator> pairIt;
                 auto comp = [](const pairIt& lhs, const pairIt& rhs) { return *lhs.first > *rhs.first; };
                 std::priority_queue<pairIt, std::vector<pairIt>, decltype(comp)> pq(comp);
                 pq.push(std::make_pair(neighbors.cbegin(), neighbors.cend()));
-                for(const std::vector<unsigned short>& v : _vecSparsity)
+                for(const std::vector<int>& v : _vecSparsity)
                     pq.push(std::make_pair(v.cbegin(), v.cend()));
                 while(!pq.empty()) {
                     pairIt p = pq.top();
@@ -114,11 +124,14 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
         template<char S, bool U>
         inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* infoNeighbor) {
             int m = U ? super::_local : *infoNeighbor;
-            std::fill(work, work + m * super::_n, 0.0);
-            for(unsigned short i = 0; i < m; ++i)
-                Wrapper<K>::sctr(super::_map[index].second.size(), in + i * super::_map[index].second.size(), super::_map[index].second.data(), work + i * super::_n);
-            Wrapper<K>::diagm(super::_n, m, _D, work, _work);
-            Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &(super::_local), &m, &(super::_n), &(Wrapper<K>::d__1), *super::_deflation, &(super::_n), _work, &(super::_n), &(Wrapper<K>::d__0), work, &(super::_local));
+            int k = super::_map[index].second.size();
+            // only the rows of the overlap with the neighbor are nonzero, so D Z is first restricted to these rows
+            for(unsigned short j = 0; j < super::_local; ++j) {
+                const K* const pt = *super::_deflation + j * super::_n;
+                for(int i = 0; i < k; ++i)
+                    _work[j * k + i] = _D[super::_map[index].second[i]] * pt[super::_map[index].second[i]];
+            }
+            Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &(super::_local), &m, &k, &(Wrapper<K>::d__1), _work, &k, in, &k, &(Wrapper<K>::d__0), work, &(super::_local));
         }
     public:
         template<template<class> class Solver, char S, class T> friend class CoarseOperator;
@@ -152,7 +165,7 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
                 _C->_ia[0] = (Wrapper<K>::I == 'F');
                 nnz = 0;
                 unsigned int i;
-#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+#pragma omp parallel for schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY))
                 for(i = 0; i < _A->_n; ++i)
                     std::sort(v[i].begin(), v[i].end(), [](const std::pair<unsigned int, K>& lhs, const std::pair<unsigned int, K>& rhs) { return lhs.first < rhs.first; });
                 for(i = 0; i < _A->_n; ++i) {
@@ -205,8 +218,8 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
                     *pt = arrayC[j * super::_local + i];
             }
         }
-        template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        template<char S, char N, bool U, class T>
+        inline void applyFromNeighborMaster(const K* in, unsigned short index, T* I, T* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
             applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
             unsigned int offset = U ? super::_map[index].first * super::_local + (N == 'F') : *offsetJ;
             for(unsigned short i = 0; i < super::_local; ++i) {
@@ -228,13 +241,13 @@ template<class Preconditioner, class K>
 class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
     private:
         typedef OperatorBase<'c', Preconditioner, K>                super;
-        std::unordered_map<unsigned short, unsigned short>       _offsets;
+        std::unordered_map<int, unsigned int>                    _offsets;
         unsigned short                                       _consolidate;
         template<char S, bool U>
         inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* info) {
-            unsigned short rankWorld = super::_p.getRank();
+            int rankWorld = super::_p.getRank();
             unsigned short between   = super::_p.getSigned();
-            std::vector<unsigned short>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), rankWorld);
+            std::vector<int>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), rankWorld);
             unsigned int accumulate = 0;
             if(!(index < between)) {
                 for(unsigned short k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k) {
@@ -250,11 +263,11 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 }
                 accumulate += (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]) * super::_map[index].second.size();
             }
-            std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+            std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
             if(S != 'S')
-                for(std::vector<unsigned short>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
+                for(std::vector<int>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
                     if(!U) {
-                        std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                        std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                         if(*it > super::_map[index].first || between > index)
                             for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                                 for(unsigned int j = 0; j < super::_map[index].second.size(); ++j) {
@@ -295,9 +308,9 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                         work[_offsets[rankWorld] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                 }
             accumulate += super::_local * super::_map[index].second.size();
-            for(std::vector<unsigned short>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
+            for(std::vector<int>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
                 if(!U) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                    std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                     if(*it > super::_map[index].first && between > index)
                         for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                             for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
@@ -341,31 +354,31 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
         inline void initialize(unsigned int, K*&, unsigned short) { }
         template<char S, bool U, class T>
         inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
-            unsigned short rankWorld = super::_p.getRank();
+            int rankWorld = super::_p.getRank();
             unsigned short between = super::_p.getSigned();
             unsigned short* infoNeighbor;
             if(!U) {
                 infoNeighbor = new unsigned short[super::_map.size()];
-                std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+                std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
                 for(unsigned short i = 0; i < super::_map.size(); ++i) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), super::_map[i].first);
+                    std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), super::_map[i].first);
                     infoNeighbor[i] = info[std::distance(super::_sparsity.cbegin(), idx)];
                     begin = idx + 1;
                 }
             }
             if(S != 'S') {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), super::_local);
+                    unsigned int size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), super::_local);
                     for(unsigned short i = 0; i < super::_map.size(); ++i)
                         in[i] = new K[size * super::_map[i].second.size()];
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         size = infoNeighbor[i];
-                        std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
-                        for(const unsigned short& rank : super::_vecSparsity[i]) {
+                        std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
+                        for(const int& rank : super::_vecSparsity[i]) {
                             if(rank == rankWorld)
                                 size += super::_local;
                             else {
-                                std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), rank);
+                                std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), rank);
                                 size += info[std::distance(super::_sparsity.cbegin(), idx)];
                                 begin = idx + 1;
                             }
@@ -388,16 +401,16 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
             }
             else {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), 0);
+                    unsigned int size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), 0);
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         in[i] = new K[(size + super::_local * (i < between)) * super::_map[i].second.size()];
                         size -= infoNeighbor[i];
                     }
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         size = infoNeighbor[i] * !(i < between) + super::_local;
-                        std::vector<unsigned short>::const_iterator end = super::_sparsity.cend();
-                        for(std::vector<unsigned short>::const_reverse_iterator rit = super::_vecSparsity[i].rbegin(); *rit > rankWorld; ++rit) {
-                            std::vector<unsigned short>::const_iterator idx = std::lower_bound(super::_sparsity.cbegin(), end, *rit);
+                        std::vector<int>::const_iterator end = super::_sparsity.cend();
+                        for(std::vector<int>::const_reverse_iterator rit = super::_vecSparsity[i].rbegin(); *rit > rankWorld; ++rit) {
+                            std::vector<int>::const_iterator idx = std::lower_bound(super::_sparsity.cbegin(), end, *rit);
                             size += info[std::distance(super::_sparsity.cbegin(), idx)];
                             end = idx - 1;
                         }
@@ -427,7 +440,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 offset[i] = offset[i - 1] + (U ? super::_local : infoNeighbor[i - 2]);
             const int nbMult = super::_p.getMult();
             K* mult = new K[offset[super::_map.size() + 1] * nbMult];
-            unsigned short* accumulator = new unsigned short[super::_map.size() + 1];
+            unsigned int* accumulator = new unsigned int[super::_map.size() + 1];
             accumulator[0] = 0;
             for(unsigned short i = 0; i < super::_map.size(); ++i) {
                 MPI_Irecv(mult + offset[i + 1] * nbMult + accumulator[i] * (U ? super::_local : infoNeighbor[i]), super::_map[i].second.size() * (U ? super::_local : infoNeighbor[i]), Wrapper<K>::mpi_type(), super::_map[i].first, 11, super::_p.Subdomain<K>::getCommunicator(), rqMult + i);
@@ -464,8 +477,11 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
 
             delete [] accumulator;
 
-            if(offset[super::_map.size() + 1])
-                super::_p.applyLocalPreconditioner(tmp, offset[super::_map.size() + 1]);
+            if(offset[super::_map.size() + 1]) {
+                K* work = new K[super::_p.getWorkspace(offset[super::_map.size() + 1])];
+                super::_p.applyLocalPreconditioner(tmp, offset[super::_map.size() + 1], work);
+                delete [] work;
+            }
 
             MPI_Waitall(super::_map.size(), rqMult + super::_map.size(), MPI_STATUSES_IGNORE);
             delete [] rqMult;
@@ -559,8 +575,8 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                     }
             }
         }
-        template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        template<char S, char N, bool U, class T>
+        inline void applyFromNeighborMaster(const K* in, unsigned short index, T* I, T* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
             assembleForMaster<S, U>(C, in, coefficients, index, arrayC, infoNeighbor);
             if(_consolidate == super::_map.size()) {
                 unsigned short between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
@@ -611,13 +627,13 @@ template<class Preconditioner, class K>
 class BddProjection : public OperatorBase<'c', Preconditioner, K> {
     private:
         typedef OperatorBase<'c', Preconditioner, K>                super;
-        std::unordered_map<unsigned short, unsigned short>       _offsets;
+        std::unordered_map<int, unsigned int>                    _offsets;
         unsigned short                                       _consolidate;
         template<char S, bool U>
         inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* info) {
-            unsigned short rankWorld = super::_p.getRank();
+            int rankWorld = super::_p.getRank();
             unsigned short between   = super::_p.getSigned();
-            std::vector<unsigned short>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), rankWorld);
+            std::vector<int>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), rankWorld);
             unsigned int accumulate = 0;
             if(S != 'S' || !(index < between)) {
                 for(unsigned short k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k)
@@ -625,11 +641,11 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                         work[_offsets[super::_map[index].first] + super::_map[index].second[j] + k * super::_n] += in[k * super::_map[index].second.size() + j];
                 accumulate += (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]) * super::_map[index].second.size();
             }
-            std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+            std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
             if(S != 'S')
-                for(std::vector<unsigned short>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
+                for(std::vector<int>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
                     if(!U) {
-                        std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                        std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                         for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                             for(unsigned int j = 0; j < super::_map[index].second.size(); ++j) {
                                 work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
@@ -651,9 +667,9 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                     work[_offsets[rankWorld] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
             }
             accumulate += super::_local * super::_map[index].second.size();
-            for(std::vector<unsigned short>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
+            for(std::vector<int>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
                 if(!U) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                    std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                     for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                         for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                             work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
@@ -685,31 +701,31 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
         inline void initialize(unsigned int, K*&, unsigned short) { }
         template<char S, bool U, class T>
         inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
-            unsigned short rankWorld = super::_p.getRank();
+            int rankWorld = super::_p.getRank();
             unsigned short between = super::_p.getSigned();
             unsigned short* infoNeighbor;
             if(!U) {
                 infoNeighbor = new unsigned short[super::_map.size()];
-                std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+                std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
                 for(unsigned short i = 0; i < super::_map.size(); ++i) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), super::_map[i].first);
+                    std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), super::_map[i].first);
                     infoNeighbor[i] = info[std::distance(super::_sparsity.cbegin(), idx)];
                     begin = idx + 1;
                 }
             }
             if(S != 'S') {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), super::_local);
+                    unsigned int size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), super::_local);
                     for(unsigned short i = 0; i < super::_map.size(); ++i)
                         in[i] = new K[size * super::_map[i].second.size()];
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         size = infoNeighbor[i];
-                        std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
-                        for(const unsigned short& rank : super::_vecSparsity[i]) {
+                        std::vector<int>::const_iterator begin = super::_sparsity.cbegin();
+                        for(const int& rank : super::_vecSparsity[i]) {
                             if(rank == rankWorld)
                                 size += super::_local;
                             else {
-                                std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), rank);
+                                std::vector<int>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), rank);
                                 size += info[std::distance(super::_sparsity.cbegin(), idx)];
                                 begin = idx + 1;
                             }
@@ -732,16 +748,16 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
             }
             else {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), 0);
+                    unsigned int size = std::accumulate(infoNeighbor, infoNeighbor + super::_map.size(), 0);
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         in[i] = new K[(size + super::_local * (i < between)) * super::_map[i].second.size()];
                         size -= infoNeighbor[i];
                     }
                     for(unsigned short i = 0; i < super::_map.size(); ++i) {
                         size = infoNeighbor[i] * !(i < between) + super::_local;
-                        std::vector<unsigned short>::const_iterator end = super::_sparsity.cend();
-                        for(std::vector<unsigned short>::const_reverse_iterator rit = super::_vecSparsity[i].rbegin(); *rit > rankWorld; ++rit) {
-                            std::vector<unsigned short>::const_iterator idx = std::lower_bound(super::_sparsity.cbegin(), end, *rit);
+                        std::vector<int>::const_iterator end = super::_sparsity.cend();
+                        for(std::vector<int>::const_reverse_iterator rit = super::_vecSparsity[i].rbegin(); *rit > rankWorld; ++rit) {
+                            std::vector<int>::const_iterator idx = std::lower_bound(super::_sparsity.cbegin(), end, *rit);
                             size += info[std::distance(super::_sparsity.cbegin(), idx)];
                             end = idx - 1;
                         }
@@ -771,7 +787,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                 offset[i] = offset[i - 1] + (U ? super::_local : infoNeighbor[i - 2]);
             const int nbMult = super::_p.getMult();
             K* mult = new K[offset[super::_map.size() + 1] * nbMult];
-            unsigned short* accumulator = new unsigned short[super::_map.size() + 1];
+            unsigned int* accumulator = new unsigned int[super::_map.size() + 1];
             accumulator[0] = 0;
             for(unsigned short i = 0; i < super::_map.size(); ++i) {
                 MPI_Irecv(mult + offset[i + 1] * nbMult + accumulator[i] * (U ? super::_local : infoNeighbor[i]), super::_map[i].second.size() * (U ? super::_local : infoNeighbor[i]), Wrapper<K>::mpi_type(), super::_map[i].first, 11, super::_p.Subdomain<K>::getCommunicator(), rqMult + i);
@@ -797,8 +813,11 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
 
             delete [] accumulator;
 
-            if(offset[super::_map.size() + 1])
-                super::_p.applyLocalSchurComplement(tmp, offset[super::_map.size() + 1]);
+            if(offset[super::_map.size() + 1]) {
+                K* work = new K[super::_p.getWorkspace(offset[super::_map.size() + 1])];
+                super::_p.template applyLocalSchurComplement<true>(tmp, offset[super::_map.size() + 1], work);
+                delete [] work;
+            }
 
             MPI_Waitall(super::_map.size(), rqMult + super::_map.size(), MPI_STATUSES_IGNORE);
             delete [] rqMult;
@@ -879,8 +898,190 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                     }
             }
         }
-        template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        template<char S, char N, bool U, class T>
+        inline void applyFromNeighborMaster(const K* in, unsigned short index, T* I, T* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+            assembleForMaster<S, U>(C, in, coefficients, index, arrayC, infoNeighbor);
+            if(_consolidate == super::_map.size()) {
+                unsigned short between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
+                unsigned int offset = 0;
+                if(S != 'S')
+                    for(unsigned short k = 0; k < between; ++k)
+                        for(unsigned short i = 0; i < super::_local; ++i) {
+                            unsigned int l = offset + coefficients * i;
+                            for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+#ifndef HPDDM_CSR_CO
+                                I[l + j] = offsetI + i;
+#endif
+                                J[l + j] = (U ? super::_sparsity[k] * super::_local + (N == 'F') : offsetJ[k]) + j;
+                            }
+                        offset += U ? super::_local : infoNeighbor[k];
+                    }
+                else
+                    coefficients += super::_local - 1;
+                for(unsigned short i = 0; i < super::_local; ++i) {
+                    unsigned int l = offset + coefficients * i - (S == 'S') * ((i * (i - 1)) / 2);
+                    for(unsigned short j = (S == 'S') * i; j < super::_local; ++j) {
+#ifndef HPDDM_CSR_CO
+                        I[l + j] = offsetI + i;
+#endif
+                        J[l + j] = offsetI + j;
+                    }
+                }
+                offset += super::_local;
+                for(unsigned short k = between; k < super::_sparsity.size(); ++k) {
+                    for(unsigned short i = 0; i < super::_local; ++i) {
+                        unsigned int l = offset + coefficients * i - (S == 'S') * ((i * (i - 1)) / 2);
+                        for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+#ifndef HPDDM_CSR_CO
+                            I[l + j] = offsetI + i;
+#endif
+                            J[l + j] = (U ? super::_sparsity[k] * super::_local + (N == 'F') : offsetJ[k - (S == 'S') * between]) + j;
+                        }
+                    }
+                    offset += U ? super::_local : infoNeighbor[k];
+                }
+            }
+        }
+};
+
+template<class Preconditioner, class K>
+class BddcAssembly : public OperatorBase<'c', Preconditioner, K> {
+    private:
+        typedef OperatorBase<'c', Preconditioner, K>                super;
+        const K* const                                      _contribution;
+        std::unordered_map<int, unsigned int>                    _offsets;
+        std::vector<std::vector<int>>                            _columns;
+        unsigned int                                        _coefficients;
+        unsigned short                                       _consolidate;
+        template<char S, bool U>
+        inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short*) {
+            const int rankWorld = super::_p.getRank();
+            const std::vector<std::pair<int, unsigned int>>& owners = super::_p.getOwners();
+            const std::vector<int>& columns = _columns[index];
+            unsigned int accumulate = 0;
+            for(const int& i : super::_p.getShared()[index])
+                if(owners[i].first == rankWorld) {
+                    for(unsigned int j = 0; j < columns.size(); ++j)
+                        if(columns[j] != -1)
+                            work[owners[i].second * _coefficients + columns[j]] += in[accumulate + j];
+                    accumulate += columns.size();
+                }
+        }
+    public:
+        template<template<class> class Solver, char S, class T> friend class CoarseOperator;
+        BddcAssembly(const Preconditioner& p, const unsigned short& nu, const K* const contribution) : OperatorBase<'c', Preconditioner, K>(p, nu, p.getRank()), _contribution(contribution), _coefficients(), _consolidate() { }
+        ~BddcAssembly() { }
+        inline void initialize(unsigned int, K*&, unsigned short) { }
+        template<char S, bool U, class T>
+        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
+            const int rankWorld = super::_p.getRank();
+            const std::vector<std::pair<int, unsigned int>>& owners = super::_p.getOwners();
+            const std::vector<std::vector<int>>& shared = super::_p.getShared();
+            const int c = super::_p.getPrimal();
+            unsigned int accumulate = 0;
+            unsigned short stop = std::distance(super::_sparsity.cbegin(), std::upper_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), rankWorld));
+            if(S != 'S') {
+                _offsets.reserve(super::_sparsity.size() + 1);
+                for(unsigned short i = 0; i < stop; ++i) {
+                    _offsets.emplace(super::_sparsity[i], accumulate);
+                    accumulate += U ? super::_local : info[i];
+                }
+            }
+            else
+                _offsets.reserve(super::_sparsity.size() + 1 - stop);
+            _offsets.emplace(rankWorld, accumulate);
+            accumulate += super::_local;
+            for(unsigned short i = stop; i < super::_sparsity.size(); ++i) {
+                _offsets.emplace(super::_sparsity[i], accumulate);
+                accumulate += U ? super::_local : info[i];
+            }
+            _coefficients = accumulate;
+            work = new K[super::_local * _coefficients]();
+
+            // the columns of the local contributions are identified by the owners of the primal constraints and by their indices on these owners
+            MPI_Request* rq = new MPI_Request[2 * super::_map.size()];
+            int* sizes = new int[super::_map.size()];
+            for(unsigned short i = 0; i < super::_map.size(); ++i) {
+                MPI_Irecv(sizes + i, 1, MPI_INT, super::_map[i].first, 12, super::_p.getCommunicator(), rq + i);
+                MPI_Isend(const_cast<int*>(&c), 1, MPI_INT, super::_map[i].first, 12, super::_p.getCommunicator(), rq + super::_map.size() + i);
+            }
+            MPI_Waitall(2 * super::_map.size(), rq, MPI_STATUSES_IGNORE);
+            int* ids = new int[2 * (c + std::accumulate(sizes, sizes + super::_map.size(), 0))];
+            for(int j = 0; j < c; ++j) {
+                ids[2 * j] = owners[j].first;
+                ids[2 * j + 1] = owners[j].second;
+            }
+            accumulate = 2 * c;
+            for(unsigned short i = 0; i < super::_map.size(); ++i) {
+                MPI_Irecv(ids + accumulate, 2 * sizes[i], MPI_INT, super::_map[i].first, 13, super::_p.getCommunicator(), rq + i);
+                MPI_Isend(ids, 2 * c, MPI_INT, super::_map[i].first, 13, super::_p.getCommunicator(), rq + super::_map.size() + i);
+                accumulate += 2 * sizes[i];
+            }
+            MPI_Waitall(2 * super::_map.size(), rq, MPI_STATUSES_IGNORE);
+            _columns.resize(super::_map.size());
+            accumulate = 2 * c;
+            for(unsigned short i = 0; i < super::_map.size(); ++i) {
+                _columns[i].resize(sizes[i]);
+                for(int j = 0; j < sizes[i]; ++j) {
+                    std::unordered_map<int, unsigned int>::const_iterator it = _offsets.find(ids[accumulate + 2 * j]);
+                    _columns[i][j] = it != _offsets.cend() ? it->second + ids[accumulate + 2 * j + 1] : -1;
+                }
+                accumulate += 2 * sizes[i];
+            }
+            for(int i = 0; i < c; ++i)
+                if(owners[i].first == rankWorld)
+                    for(int j = 0; j < c; ++j) {
+                        std::unordered_map<int, unsigned int>::const_iterator it = _offsets.find(owners[j].first);
+                        if(it != _offsets.cend())
+                            work[owners[i].second * _coefficients + it->second + owners[j].second] += _contribution[i + j * c];
+                    }
+            delete [] ids;
+            delete [] rq;
+
+            MPI_Request r;
+            for(unsigned short i = 0; i < super::_map.size(); ++i) {
+                unsigned int rows = 0;
+                for(const int& j : shared[i])
+                    if(owners[j].first == super::_map[i].first)
+                        ++rows;
+                in[i] = new K[rows * c];
+                rows = 0;
+                for(const int& j : shared[i])
+                    if(owners[j].first == super::_map[i].first) {
+                        for(int k = 0; k < c; ++k)
+                            in[i][rows * c + k] = _contribution[j + k * c];
+                        ++rows;
+                    }
+                if(U || info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[i].first))]) {
+                    MPI_Isend(in[i], rows * c, Wrapper<K>::mpi_type(), super::_map[i].first, 2, super::_p.getCommunicator(), &r);
+                    rqSend.emplace_back(r);
+                }
+                if(U || super::_local) {
+                    rows = 0;
+                    for(const int& j : shared[i])
+                        if(owners[j].first == rankWorld)
+                            ++rows;
+                    out[i] = new K[rows * sizes[i]];
+                    MPI_Irecv(out[i], rows * sizes[i], Wrapper<K>::mpi_type(), super::_map[i].first, 2, super::_p.getCommunicator(), rqRecv + i);
+                }
+                else
+                    rqRecv[i] = MPI_REQUEST_NULL;
+            }
+            delete [] sizes;
+        }
+        template<char S, bool U>
+        inline void assembleForMaster(K* C, const K* in, const int& coefficients, unsigned short index, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+            applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
+            if(++_consolidate == super::_map.size()) {
+                if(S != 'S')
+                    std::copy_n(arrayC, super::_local * _coefficients, C);
+                else
+                    for(unsigned short j = 0; j < super::_local; ++j)
+                        std::copy(arrayC + j * _coefficients + j, arrayC + (j + 1) * _coefficients, C - (j * (j - 1)) / 2 + j * (coefficients + super::_local));
+            }
+        }
+        template<char S, char N, bool U, class T>
+        inline void applyFromNeighborMaster(const K* in, unsigned short index, T* I, T* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
             assembleForMaster<S, U>(C, in, coefficients, index, arrayC, infoNeighbor);
             if(_consolidate == super::_map.size()) {
                 unsigned short between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
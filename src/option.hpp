@@ -0,0 +1,192 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): Pierre Jolivet <jolivet@ann.jussieu.fr>
+        Date: 2015-01-12
+
+   Copyright (C) 2011-2014 Université de Grenoble
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OPTION_
+#define _OPTION_
+
+#include <cstdlib>
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <unordered_map>
+
+namespace HPDDM {
+/* Class: Option
+ *
+ *  A class to handle runtime options. Each option is a name associated to a numerical value, and the compile-time HPDDM_* constants are only used as default values. Options are read, in this order, from:
+ *    - the environment variable HPDDM_OPTIONS, when <Option> is first accessed,
+ *    - a file, see <Option::parseFile>,
+ *    - the command line, see <Option::parse>.
+ *
+ *  The following options are currently queried:
+ *    granularity        - Granularity for OpenMP scheduling, see <HPDDM_GRANULARITY>.
+ *    gmv                - Reduced volume of communication in <Schwarz::GMV>, see <HPDDM_GMV>.
+ *    async              - Nonblocking coarse corrections in <Schwarz::apply>, see <HPDDM_ICOLLECTIVE>.
+ *    strategy           - Ordering strategy of the coarse direct solver, overrides <Parameter::STRATEGY>.
+ *    sub_strategy       - Ordering strategy of the local direct solvers.
+ *    sub_ooc            - Out-of-core factorization of the local matrices with MUMPS, in the directory given by the environment variable HPDDM_OOC_TMPDIR where "%d" is replaced by the rank of the process.
+ *    sub_blr            - Dropping parameter of the block low-rank factorization of the local matrices with MUMPS, disabled if nonpositive.
+ *    verbosity          - Verbosity of <Coarse operator::tune>, and of the <Iterative method>s where it overrides the value supplied by the caller.
+ *    schur_chunk        - Minimum number of scalars per message when exchanging local Schur complements in <Schur::exchangeSchurComplement>.
+ *    geneo_partial      - Computation of the smallest eigenpairs of the GenEO problem by <Lapack::partial> instead of <Lapack::solve> in <Schur::solveGEVP>.
+ *    geneo_threads      - Number of OpenMP threads of each process in <Schur::solveGEVP>, or, if negative, the number of cores of a node divided by its number of processes. BLAS and LAPACK are only affected if they follow omp_set_num_threads.
+ *    tune_flops         - Floating-point operations per second used by <Coarse operator::tune>.
+ *    tune_latency       - Network latency in seconds used by <Coarse operator::tune>.
+ *    tune_bandwidth     - Network bandwidth in bytes per second used by <Coarse operator::tune>.
+ *    tune_calibrate     - Calibration of those of the three previous values that are not set with a micro-benchmark, run once by <Coarse operator::tune>, enabled by default.
+ *    tune_iterations    - Expected number of coarse corrections used by <Coarse operator::tune>.
+ *    replicate          - Replication of the factors of the coarse operator by <Dense LAPACK::replicate>, on all processes if set to one, once per node if set to two, or once per node in shared memory if set to three. */
+class Option {
+    private:
+        /* Variable: opt
+         *  Map of option names and values. */
+        std::unordered_map<std::string, double> _opt;
+        Option() {
+            const char* const env = std::getenv("HPDDM_OPTIONS");
+            if(env) {
+                std::istringstream stream(env);
+                parse(stream, true);
+            }
+        }
+        /* Function: parse
+         *  Parses a stream of whitespace-separated tokens. Tokens must be prefixed by a dash, and by "-hpddm_" if prefix is true. An option not followed by a value is set to one. */
+        inline void parse(std::istream& stream, bool prefix) {
+            std::string name, token;
+            while(stream >> token) {
+                if(token.size() > 1 && token[0] == '-' && !std::isdigit(token[1]) && token[1] != '.') {
+                    if(!name.empty())
+                        _opt[name] = 1;
+                    name = token.substr(1);
+                    if(prefix) {
+                        if(name.compare(0, 6, "hpddm_") == 0)
+                            name = name.substr(6);
+                        else
+                            name.clear();
+                    }
+                }
+                else if(!name.empty()) {
+                    char* end;
+                    double value = std::strtod(token.c_str(), &end);
+                    if(*end == '\0') {
+                        if(name == "config")
+                            std::cerr << "WARNING -- the option " << name << " expects a file name" << std::endl;
+                        else
+                            _opt[name] = value;
+                    }
+                    else if(name == "config")
+                        parseFile(token);
+                    else
+                        std::cerr << "WARNING -- ignoring the value " << token << " of the option " << name << std::endl;
+                    name.clear();
+                }
+            }
+            if(!name.empty())
+                _opt[name] = 1;
+        }
+    public:
+        Option(const Option&) = delete;
+        /* Function: get
+         *  Returns a reference to the unique instance of <Option>. */
+        static inline Option& get() {
+            static Option opt;
+            return opt;
+        }
+        /* Function: parse
+         *
+         *  Parses the command line. Only arguments prefixed by "-hpddm_" are considered, e.g. "-hpddm_granularity 10000" or "-hpddm_gmv". The argument "-hpddm_config" followed by a file name calls <Option::parseFile>.
+         *
+         * Parameters:
+         *    argc           - Number of arguments.
+         *    argv           - Array of arguments. */
+        inline void parse(int argc, char** argv) {
+            std::stringstream stream;
+            for(int i = 1; i < argc; ++i)
+                stream << argv[i] << " ";
+            parse(stream, true);
+        }
+        template<class Container>
+        inline void parse(const Container& arguments) {
+            std::stringstream stream;
+            for(const std::string& s : arguments)
+                stream << s << " ";
+            parse(stream, true);
+        }
+        /* Function: parseFile
+         *
+         *  Parses a file. Each line holds an option name, with or without the "-hpddm_" prefix, optionally followed by a value. Characters following a '#' are ignored.
+         *
+         * Parameter:
+         *    filename       - Name of the file. */
+        inline void parseFile(const std::string& filename) {
+            std::ifstream file(filename);
+            if(!file.good()) {
+                std::cerr << "WARNING -- could not open the file " << filename << std::endl;
+                return;
+            }
+            std::stringstream stream;
+            std::string line;
+            while(std::getline(file, line)) {
+                line = line.substr(0, line.find('#'));
+                std::istringstream tokens(line);
+                std::string name;
+                if(tokens >> name) {
+                    if(name[0] != '-')
+                        name = "-" + name;
+                    else if(name.compare(0, 7, "-hpddm_") == 0)
+                        name = "-" + name.substr(7);
+                    stream << name << " ";
+                    std::string value;
+                    if(tokens >> value)
+                        stream << value << " ";
+                }
+            }
+            parse(stream, false);
+        }
+        /* Function: set
+         *  Sets the value of an option. */
+        inline void set(const std::string& name, double value) { _opt[name] = value; }
+        /* Function: remove
+         *  Removes an option. */
+        inline void remove(const std::string& name) { _opt.erase(name); }
+        /* Function: any
+         *  Returns true if an option is set, false otherwise. */
+        inline bool any(const std::string& name) const { return _opt.find(name) != _opt.cend(); }
+        /* Function: val
+         *
+         *  Returns the value of an option.
+         *
+         * Template Parameter:
+         *    T              - Type of the returned value.
+         *
+         * Parameters:
+         *    name           - Name of the option.
+         *    d              - Default value if the option is not set. */
+        template<class T>
+        inline T val(const std::string& name, T d) const {
+            std::unordered_map<std::string, double>::const_iterator it = _opt.find(name);
+            return it != _opt.cend() ? static_cast<T>(it->second) : d;
+        }
+};
+} // HPDDM
+#endif // _OPTION_
@@ -49,8 +49,15 @@ class Preconditioner : public Subdomain<K> {
         /* Variable: uc
          *  Workspace array of size <Coarse operator::local>. */
         K*                 _uc;
+        /* Variable: evc
+         *  Thresholded deflation vectors stored row-wise in Compressed Sparse Row format, see <Preconditioner::compressVectors>. */
+        MatrixCSR<K>*     _evc;
+        template<class T, typename std::enable_if<std::is_same<T, typename Wrapper<T>::ul_type>::value>::type* = nullptr>
+        static inline T conj(const T& x) { return x; }
+        template<class T, typename std::enable_if<!std::is_same<T, typename Wrapper<T>::ul_type>::value>::type* = nullptr>
+        static inline T conj(const T& x) { return std::conj(x); }
     public:
-        Preconditioner() : _co(), _ev(), _uc() { }
+        Preconditioner() : _co(), _ev(), _uc(), _evc() { }
         Preconditioner(const Preconditioner&) = delete;
         ~Preconditioner() {
             delete _co;
@@ -58,6 +65,7 @@ class Preconditioner : public Subdomain<K> {
                 delete [] *_ev;
             delete [] _ev;
             delete [] _uc;
+            delete _evc;
         }
         /* Function: initialize
          *
@@ -115,6 +123,80 @@ class Preconditioner : public Subdomain<K> {
             }
             return ret;
         }
+        /* Function: compressVectors
+         *
+         *  Builds <Preconditioner::evc> by dropping the coefficients of the deflation vectors lower than a threshold. The compressed vectors are only kept, and true is returned, if they require less memory than the dense ones.
+         *
+         * Parameters:
+         *    threshold      - Drop tolerance.
+         *    n              - Number of rows of the compressed vectors.
+         *    offset         - Index of the first row of <Preconditioner::ev> to compress (optional).
+         *    ld             - Leading dimension of <Preconditioner::ev> (optional). */
+        inline bool compressVectors(const typename Wrapper<K>::ul_type& threshold, const int& n, const int& offset = 0, int ld = 0) {
+            delete _evc;
+            _evc = nullptr;
+            const unsigned short nu = getLocal();
+            if(!_ev || nu == 0)
+                return false;
+            if(ld == 0)
+                ld = n;
+            int nnz = 0;
+            for(unsigned short i = 0; i < nu; ++i)
+                nnz += std::count_if(*_ev + offset + i * ld, *_ev + offset + i * ld + n, [&](const K& z) { return std::abs(z) > threshold; });
+            if(nnz * (sizeof(K) + sizeof(int)) + (nu + 1) * sizeof(int) >= nu * n * sizeof(K))
+                return false;
+            _evc = new MatrixCSR<K>(nu, n, nnz, false);
+            _evc->_ia[0] = nnz = 0;
+            for(unsigned short i = 0; i < nu; ++i) {
+                const K* const z = *_ev + offset + i * ld;
+                for(int j = 0; j < n; ++j)
+                    if(std::abs(z[j]) > threshold) {
+                        _evc->_ja[nnz] = j;
+                        _evc->_a[nnz++] = z[j];
+                    }
+                _evc->_ia[i + 1] = nnz;
+            }
+            return true;
+        }
+        /* Function: applyVectors
+         *
+         *  Multiplies a vector by the compressed deflation vectors <Preconditioner::evc>, i.e. computes out = Z in if trans is 'N', out = Z^T in if trans is 'T', and out = Z^H in if trans is 'C'. With multiple vectors, coarse vectors are stored one coarse degree of freedom after the other, see <Coarse operator::callSolver>.
+         *
+         * Template Parameter:
+         *    trans          - 'N', 'T' or 'C'.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector.
+         *    mu             - Number of vectors (optional).
+         *    ld             - Leading dimension of the fine vectors (optional). */
+        template<char trans>
+        inline void applyVectors(const K* const in, K* const out, const unsigned short& mu = 1, const int& ld = 0) const {
+            static_assert(trans == 'N' || trans == 'T' || trans == 'C', "Unsupported value for argument 'trans'");
+            if(trans == 'N') {
+                for(unsigned short k = 0; k < mu; ++k)
+                    std::fill(out + k * ld, out + k * ld + _evc->_m, K());
+                for(int i = 0; i < _evc->_n; ++i)
+                    for(int j = _evc->_ia[i]; j < _evc->_ia[i + 1]; ++j)
+                        for(unsigned short k = 0; k < mu; ++k)
+                            out[_evc->_ja[j] + k * ld] += _evc->_a[j] * in[i * mu + k];
+            }
+            else {
+                int i;
+#pragma omp parallel for schedule(static, 1)
+                for(i = 0; i < _evc->_n; ++i) {
+                    for(unsigned short k = 0; k < mu; ++k) {
+                        K res = K();
+                        for(int j = _evc->_ia[i]; j < _evc->_ia[i + 1]; ++j)
+                            res += (trans == 'C' ? conj(_evc->_a[j]) : _evc->_a[j]) * in[_evc->_ja[j] + k * ld];
+                        out[i * mu + k] = res;
+                    }
+                }
+            }
+        }
+        /* Function: getCompressedVectors
+         *  Returns a constant pointer to <Preconditioner::evc>. */
+        inline const MatrixCSR<K>* getCompressedVectors() const { return _evc; }
         /* Function: getVectors
          *  Returns a constant pointer to <Preconditioner::ev>. */
         inline K** getVectors() const { return _ev; }
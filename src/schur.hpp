@@ -23,6 +23,8 @@
 #ifndef _SCHUR_
 #define _SCHUR_
 
+#include <random>
+
 namespace HPDDM {
 /* Class: Schur
  *
@@ -37,66 +39,90 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
     private:
         /* Function: exchangeSchurComplement
          *
-         *  Exchanges the local Schur complements <Schur::schur> to form an explicit restriction of the global Schur complement.
+         *  Exchanges the local Schur complements <Schur::schur> to form an explicit restriction of the global Schur complement. Messages are split in chunks of at least "schur_chunk" scalars, see <Option>, accumulated in packed storage as they arrive.
          *
          * Template Parameter:
          *    L              - 'S'ymmetric or 'G'eneral transfer of the local Schur complements.
          *
          * Parameters:
-         *    rq             - MPI request to check completion of the MPI transfers.
+         *    rq             - MPI requests to check completion of the MPI sends.
          *    send           - Buffer for sending the local Schur complement.
          *    recv           - Buffer for receiving the local Schur complement of each neighboring subdomains.
-         *    res            - Restriction of the global Schur complement. */
+         *    res            - Restriction of the global Schur complement, lower triangular part in packed storage. */
         template<char L>
-        inline void exchangeSchurComplement(MPI_Request* const& rq, K* const* const& send, K* const* const& recv, K* const& res) const {
+        inline void exchangeSchurComplement(std::vector<MPI_Request>& rq, K* const* const& send, K* const* const& recv, K* const& res) const {
             if(send && recv && res) {
-                if(L == 'S')
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        MPI_Irecv(recv[i], (Subdomain<K>::_map[i].second.size() * (Subdomain<K>::_map[i].second.size() + 1)) / 2, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq + i);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                            for(unsigned int k = j; k < Subdomain<K>::_map[i].second.size(); ++k) {
-                                if(Subdomain<K>::_map[i].second[j] < Subdomain<K>::_map[i].second[k])
-                                    send[i][Subdomain<K>::_map[i].second.size() * j - (j * (j + 1)) / 2 + k] = _schur[Subdomain<K>::_map[i].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[k]];
-                                else
-                                    send[i][Subdomain<K>::_map[i].second.size() * j - (j * (j + 1)) / 2 + k] = _schur[Subdomain<K>::_map[i].second[k] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[j]];
-                            }
-                        MPI_Isend(send[i], (Subdomain<K>::_map[i].second.size() * (Subdomain<K>::_map[i].second.size() + 1)) / 2, Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq + Subdomain<K>::_map.size() + i);
+                const vectorNeighbor& map = Subdomain<K>::_map;
+                const unsigned int dof = Subdomain<K>::_dof;
+                const unsigned int chunk = std::max(1, Option::get().val("schur_chunk", 65536));
+                auto packed = [](unsigned int n, unsigned int j) { return n * j - (j * (j + 1)) / 2; };
+                auto offset = [&](unsigned int n, unsigned int j) { return L == 'S' ? packed(n, j) : n * j; };
+                auto start = [&](unsigned int n, unsigned int j) { return offset(n, j) + (L == 'S' ? j : 0); };
+                std::vector<std::vector<unsigned int>> rows(map.size());
+                std::vector<std::pair<unsigned short, unsigned int>> chunks;
+                for(unsigned short i = 0; i < map.size(); ++i) {
+                    const unsigned int n = map[i].second.size();
+                    rows[i].emplace_back(0);
+                    for(unsigned int j = 1; j <= n; ++j)
+                        if(j == n || start(n, j) - start(n, rows[i].back()) >= chunk)
+                            rows[i].emplace_back(j);
+                    for(unsigned int j = 0; j < rows[i].size() - 1; ++j)
+                        chunks.emplace_back(i, j);
+                }
+                std::stable_sort(chunks.begin(), chunks.end(), [](const std::pair<unsigned short, unsigned int>& lhs, const std::pair<unsigned short, unsigned int>& rhs) { return lhs.second < rhs.second; });
+                std::vector<MPI_Request> rqRecv(chunks.size());
+                for(unsigned int c = 0; c < chunks.size(); ++c) {
+                    const unsigned short i = chunks[c].first;
+                    const unsigned int n = map[i].second.size();
+                    const unsigned int begin = start(n, rows[i][chunks[c].second]);
+                    MPI_Irecv(recv[i] + begin, start(n, rows[i][chunks[c].second + 1]) - begin, Wrapper<K>::mpi_type(), map[i].first, 1, Subdomain<K>::_communicator, rqRecv.data() + c);
+                }
+                for(unsigned int j = 0; j < dof; ++j)
+                    std::copy_n(_schur + j * dof + j, dof - j, res + packed(dof, j) + j);
+                auto accumulate = [&](int c) {
+                    const unsigned short i = chunks[c].first;
+                    const unsigned int n = map[i].second.size();
+                    for(unsigned int j = rows[i][chunks[c].second]; j < rows[i][chunks[c].second + 1]; ++j) {
+                        const K* const pt = recv[i] + offset(n, j);
+                        for(unsigned int k = (L == 'S' ? j : 0); k < n; ++k) {
+                            if(map[i].second[j] <= map[i].second[k])
+                                res[packed(dof, map[i].second[j]) + map[i].second[k]] += pt[k];
+                            else if(L == 'S')
+                                res[packed(dof, map[i].second[k]) + map[i].second[j]] += pt[k];
+                        }
                     }
-                else
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        MPI_Irecv(recv[i], Subdomain<K>::_map[i].second.size() * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq + i);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                            for(unsigned int k = 0; k < Subdomain<K>::_map[i].second.size(); ++k) {
-                                if(Subdomain<K>::_map[i].second[j] < Subdomain<K>::_map[i].second[k])
-                                    send[i][j * Subdomain<K>::_map[i].second.size() + k] = _schur[Subdomain<K>::_map[i].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[k]];
+                };
+                rq.resize(chunks.size());
+                unsigned int received = 0;
+                for(unsigned int c = 0; c < chunks.size(); ++c) {
+                    const unsigned short i = chunks[c].first;
+                    const unsigned int n = map[i].second.size();
+                    const unsigned int first = rows[i][chunks[c].second];
+                    const unsigned int last = rows[i][chunks[c].second + 1];
+                    constexpr unsigned int tile = 64;
+                    for(unsigned int kk = (L == 'S' ? first : 0); kk < n; kk += tile)
+                        for(unsigned int j = first; j < last; ++j) {
+                            K* const pt = send[i] + offset(n, j);
+                            for(unsigned int k = std::max(kk, L == 'S' ? j : 0); k < std::min(kk + tile, n); ++k) {
+                                if(map[i].second[j] < map[i].second[k])
+                                    pt[k] = _schur[map[i].second[j] * dof + map[i].second[k]];
                                 else
-                                    send[i][j * Subdomain<K>::_map[i].second.size() + k] = _schur[Subdomain<K>::_map[i].second[k] * Subdomain<K>::_dof + Subdomain<K>::_map[i].second[j]];
+                                    pt[k] = _schur[map[i].second[k] * dof + map[i].second[j]];
                             }
-                        MPI_Isend(send[i], Subdomain<K>::_map[i].second.size() * Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, rq + Subdomain<K>::_map.size() + i);
-                    }
-                Wrapper<K>::lacpy(&uplo, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), _schur, &(Subdomain<K>::_dof), res, &(Subdomain<K>::_dof));
-                if(L == 'S')
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        int index;
-                        MPI_Waitany(Subdomain<K>::_map.size(), rq, &index, MPI_STATUS_IGNORE);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[index].second.size(); ++j) {
-                            for(unsigned int k = 0; k < j; ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][Subdomain<K>::_map[index].second.size() * k - (k * (k + 1)) / 2 + j];
-                            for(unsigned int k = j; k < Subdomain<K>::_map[index].second.size(); ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][Subdomain<K>::_map[index].second.size() * j - (j * (j + 1)) / 2 + k];
                         }
+                    MPI_Isend(send[i] + start(n, first), start(n, last) - start(n, first), Wrapper<K>::mpi_type(), map[i].first, 1, Subdomain<K>::_communicator, rq.data() + c);
+                    int index, flag;
+                    MPI_Testany(rqRecv.size(), rqRecv.data(), &index, &flag, MPI_STATUS_IGNORE);
+                    if(flag && index != MPI_UNDEFINED) {
+                        accumulate(index);
+                        ++received;
                     }
-                else
-                    for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                        int index;
-                        MPI_Waitany(Subdomain<K>::_map.size(), rq, &index, MPI_STATUS_IGNORE);
-                        for(unsigned int j = 0; j < Subdomain<K>::_map[index].second.size(); ++j)
-                            for(unsigned int k = 0; k < Subdomain<K>::_map[index].second.size(); ++k)
-                                if(Subdomain<K>::_map[index].second[j] <= Subdomain<K>::_map[index].second[k])
-                                    res[Subdomain<K>::_map[index].second[j] * Subdomain<K>::_dof + Subdomain<K>::_map[index].second[k]] += recv[index][j * Subdomain<K>::_map[index].second.size() + k];
-                    }
+                }
+                for( ; received < chunks.size(); ++received) {
+                    int index;
+                    MPI_Waitany(rqRecv.size(), rqRecv.data(), &index, MPI_STATUS_IGNORE);
+                    accumulate(index);
+                }
             }
         }
     protected:
@@ -115,6 +141,18 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Variable: schur
          *  Explicit local Schur complement. */
         K*                        _schur;
+        /* Variable: hodlr
+         *  Compressed local Schur complement, see <Schur::compressSchurComplement>. */
+        Hodlr<K>*                 _hodlr;
+        /* Variable: lowRank
+         *  Columns sampled by <Schur::sampleSchurComplement>, followed by the Cholesky factor of their projection, and by a workspace of size <Schur::rank>. */
+        K*                      _lowRank;
+        /* Variable: rank
+         *  Number of columns of <Schur::lowRank>. */
+        int                        _rank;
+        /* Variable: shift
+         *  Diagonal shift of the approximation computed by <Schur::sampleSchurComplement>. */
+        typename Wrapper<K>::ul_type _shift;
         /* Variable: work
          *  Workspace array. */
         K*                         _work;
@@ -133,9 +171,12 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Variable: deficiency
          *  Dimension of the kernel of <Subdomain::a>. */
         unsigned short       _deficiency;
+        /* Variable: threads
+         *  Number of OpenMP threads of the calling process in <Schur::solveGEVP>, zero to keep the current number. */
+        int                     _threads;
         /* Function: solveGEVP
          *
-         *  Solves the GenEO problem.
+         *  Solves the GenEO problem in place in <Schur::schur>, with <Schur::threads> OpenMP threads if it is positive. The lower triangular part of <Schur::schur> is restored afterwards.
          *
          * Template Parameter:
          *    L              - 'S'ymmetric or 'G'eneral transfer of the local Schur complements.
@@ -146,8 +187,11 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    threshold      - Criterion for selecting the eigenpairs (optional). */
         template<char L>
         inline void solveGEVP(const typename Wrapper<K>::ul_type* const d, unsigned short& nu, const typename Wrapper<K>::ul_type& threshold) {
-            if(_schur) {
-                MPI_Request* rq = new MPI_Request[2 * Subdomain<K>::_map.size()];
+            if(_schur || _lowRank) {
+                const bool sampled = !_schur;
+                if(sampled)
+                    assembleSchurComplement();
+                std::vector<MPI_Request> rq;
                 K** send = new K*[2 * Subdomain<K>::_map.size()];
                 unsigned int size = 0;
                 if(L == 'S')
@@ -172,40 +216,38 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                 K* res = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
                 exchangeSchurComplement<L>(rq, send, recv, res);
 
+#ifdef _OPENMP
+                const int threads = omp_get_max_threads();
+                if(_threads > 0)
+                    omp_set_num_threads(_threads);
+#endif
                 Lapack<K> evp(nu >= 10 ? (nu >= 40 ? 1.0e-14 : 1.0e-12) : 1.0e-8, threshold, Subdomain<K>::_dof, nu);
-                K* A;
-                if(size < Subdomain<K>::_dof * Subdomain<K>::_dof)
-                    A = new K[Subdomain<K>::_dof * Subdomain<K>::_dof];
-                else
-                    A = *recv;
-                Wrapper<K>::lacpy(&uplo, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), _schur, &(Subdomain<K>::_dof), A, &(Subdomain<K>::_dof));
+                const unsigned int dof = Subdomain<K>::_dof;
+                auto packed = [&](unsigned int j) { return dof * j - (j * (j + 1)) / 2; };
                 if(d)
-                    for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i)
-                        for(unsigned int j = i; j < Subdomain<K>::_dof; ++j)
-                            res[j + i * Subdomain<K>::_dof] *= d[i] * d[j];
-                evp.reduce(A, res);
-                int flag;
-                int lwork = 64 * Subdomain<K>::_dof;
-                MPI_Testall(Subdomain<K>::_map.size(), rq + Subdomain<K>::_map.size(), &flag, MPI_STATUSES_IGNORE);
-                K* work;
-                const int storage = std::is_same<K, typename Wrapper<K>::ul_type>::value ? 4 * Subdomain<K>::_dof - 1 : 2 * Subdomain<K>::_dof;
-                if(flag) {
-                    if((lwork + storage) <= size || (A != *recv && (lwork + storage) <= 2 * size))
-                        work = *send;
-                    else
-                        work = new K[lwork + storage];
-                }
-                else {
-                    if(A != *recv && (lwork + storage) <= size)
-                        work = *recv;
-                    else
-                        work = new K[lwork + storage];
-                }
-                evp.solve(A, super::_ev, work, lwork, Subdomain<K>::_communicator);
+                    for(unsigned int i = 0; i < dof; ++i)
+                        for(unsigned int j = i; j < dof; ++j)
+                            res[packed(i) + j] *= d[i] * d[j];
+                for(unsigned int j = dof; j-- > 1; )
+                    std::copy_backward(res + packed(j) + j, res + packed(j) + dof, res + (j + 1) * dof);
+                int lwork = 64 * dof;
+                const int storage = std::is_same<K, typename Wrapper<K>::ul_type>::value ? 4 * dof - 1 : 2 * dof;
+                const unsigned int lower = (dof * (dof + 1)) / 2;
+                MPI_Waitall(rq.size(), rq.data(), MPI_STATUSES_IGNORE);
+                const bool reuse[2] = { lower <= 2 * size, (lower <= 2 * size ? lower : 0) + lwork + storage <= 2 * size };
+                K* const backup = reuse[0] ? *send : new K[lower];
+                K* const work = reuse[1] ? *send + (reuse[0] ? lower : 0) : new K[lwork + storage];
+                for(unsigned int j = 0; j < dof; ++j)
+                    std::copy_n(_schur + j * dof + j, dof - j, backup + packed(j) + j);
+                evp.reduce(_schur, res);
+                if(Option::get().val("geneo_partial", 0))
+                    evp.partial(_schur, super::_ev, work, lwork, Subdomain<K>::_communicator);
+                else
+                    evp.solve(_schur, super::_ev, work, lwork, Subdomain<K>::_communicator);
                 nu = evp.getNu();
                 _deficiency = std::distance(reinterpret_cast<typename Wrapper<K>::ul_type*>(work) + lwork, std::upper_bound(reinterpret_cast<typename Wrapper<K>::ul_type*>(work) + lwork, reinterpret_cast<typename Wrapper<K>::ul_type*>(work) + lwork + nu, evp.getTol()));
-                if(A != *recv)
-                    delete [] A;
+                for(unsigned int j = 0; j < dof; ++j)
+                    std::copy_n(backup + packed(j) + j, dof - j, _schur + j * dof + j);
                 if(nu)
                     evp.expand(res, super::_ev);
                 else if(super::_ev) {
@@ -213,37 +255,79 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     delete []  super::_ev;
                     super::_ev = nullptr;
                 }
-                if(work != *recv && work != *send)
+#ifdef _OPENMP
+                omp_set_num_threads(threads);
+#endif
+                if(!reuse[1])
                     delete [] work;
-                if(!flag)
-                    MPI_Waitall(Subdomain<K>::_map.size(), rq + Subdomain<K>::_map.size(), MPI_STATUSES_IGNORE);
+                if(!reuse[0])
+                    delete [] backup;
                 delete [] res;
-                delete [] rq;
                 delete [] *send;
                 delete [] send;
+                if(sampled) {
+                    delete [] _schur;
+                    _schur = nullptr;
+                }
             }
             else
                 nu = 0;
         }
+        /* Function: assembleSchurComplement
+         *  Allocates <Schur::schur> and assembles <Schur::bb> in it, or the approximation computed by <Schur::sampleSchurComplement> if <Schur::lowRank> is set. */
+        inline void assembleSchurComplement() {
+            const int n = Subdomain<K>::_dof;
+            _schur = new K[n * n]();
+            for(int i = 0; i < n; ++i)
+                for(int j = _bb->_ia[i] - (Wrapper<K>::I == 'F'); j < _bb->_ia[i + 1] - (Wrapper<K>::I == 'F'); ++j)
+                    _schur[i + (_bb->_ja[j] - (Wrapper<K>::I == 'F')) * n] += _bb->_a[j];
+            if(_lowRank) {
+                K* const x = new K[_rank * n];
+                for(int i = 0; i < n; ++i)
+                    for(int j = 0; j < _rank; ++j)
+                        x[j + i * _rank] = _lowRank[i + j * n];
+                conjugate(_rank, n, _rank, x);
+                int info;
+                Wrapper<K>::potrs(&uplo, &_rank, &n, _lowRank + _rank * n, &_rank, x, &_rank, &info);
+                Wrapper<K>::gemm(&transa, &transa, &n, &n, &_rank, &(Wrapper<K>::d__2), _lowRank, &n, x, &_rank, &(Wrapper<K>::d__1), _schur, &n);
+                for(int i = 0; i < n; ++i)
+                    _schur[i * (n + 1)] += _shift;
+                delete [] x;
+            }
+        }
     public:
-        Schur() : _bb(), _ii(), _bi(), _schur(), _work(), _structure(), _mult(), _signed(), _deficiency() { }
+        Schur() : _bb(), _ii(), _bi(), _schur(), _hodlr(), _lowRank(), _rank(), _shift(), _work(), _structure(), _mult(), _signed(), _deficiency(), _threads() { }
         Schur(const Schur&) = delete;
         ~Schur() {
             delete _bb;
-            if(!_schur)
-                delete _ii;
+            delete _ii;
             delete _bi;
             delete [] _schur;
+            delete _hodlr;
+            delete [] _lowRank;
             delete [] _work;
         }
         /* Typedef: super
          *  Type of the immediate parent class <Preconditioner>. */
         typedef Preconditioner<Solver, CoarseOperator, K> super;
         /* Function: initialize
-         *  Sets <Schur::rankWorld> and <Schur::signed>, and allocates <Schur::mult>, <Schur::work>, and <Schur::structure>. */
+         *  Sets <Schur::rankWorld>, <Schur::signed>, and <Schur::threads>, and allocates <Schur::mult>, <Schur::work>, and <Schur::structure>. */
         template<bool m>
         inline void initialize() {
             MPI_Comm_rank(Subdomain<K>::_communicator, &_rankWorld);
+#ifdef _OPENMP
+            _threads = Option::get().val("geneo_threads", 0);
+            if(_threads < 0) {
+                int sizeNode = 1;
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                MPI_Comm node;
+                MPI_Comm_split_type(Subdomain<K>::_communicator, MPI_COMM_TYPE_SHARED, _rankWorld, MPI_INFO_NULL, &node);
+                MPI_Comm_size(node, &sizeNode);
+                MPI_Comm_free(&node);
+#endif
+                _threads = std::max(1, omp_get_num_procs() / sizeNode);
+            }
+#endif
             for(const pairNeighbor& neighbor : Subdomain<K>::_map) {
                 _mult += neighbor.second.size();
                 if(neighbor.first < _rankWorld)
@@ -258,6 +342,24 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                 _structure = _work + Subdomain<K>::_dof;
             }
         }
+        /* Function: allocateBlock
+         *
+         *  Reallocates <Schur::work> and <Schur::structure> so that they can hold multiple vectors, followed by mu contiguous interface vectors, by buffers for <Subdomain::exchange(mu)>, see <Schur::getBuffer>, and by a workspace of size <Schur::getWorkspace>. <Preconditioner::uc> is reallocated as well to hold multiple coarse vectors.
+         *
+         * Parameter:
+         *    mu             - Number of vectors. */
+        inline void allocateBlock(const unsigned short& mu) {
+            if(super::_co) {
+                delete [] super::_uc;
+                super::_uc = new K[mu * super::_co->getSizeRHS()];
+            }
+            if(_work) {
+                const unsigned int size = _structure - _work;
+                delete [] _work;
+                _work = new K[mu * (size + Subdomain<K>::_a->_n + Subdomain<K>::_dof + 2 * _mult) + getWorkspace(mu)];
+                _structure = _work + mu * size;
+            }
+        }
         /* Function: callNumfact
          *  Factorizes <Subdomain::a>. */
         inline void callNumfact() {
@@ -291,8 +393,6 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
 #else
                 _schur[1] = _bi->_m + 1;
 #endif
-                if(_ii)
-                    delete _ii;
                 super::_s.numfact(Subdomain<K>::_a, true, _schur);
             }
             else
@@ -301,11 +401,149 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
 #warning Consider changing your linear solver if you need to compute Schur complements
 #endif
         }
+        /* Function: sampleSchurComplement
+         *
+         *  Approximates the local Schur complement by <Schur::bb>, plus a diagonal shift, minus a low-rank approximation of the contribution of the interior degrees of freedom stored in <Schur::lowRank>. This must be called after <Schur::callNumfactPreconditioner>, and small interfaces get an exact <Schur::schur> instead.
+         *
+         * Parameter:
+         *    k              - Number of random vectors, without oversampling (optional). */
+        inline void sampleSchurComplement(int k = 64) {
+            if(_schur || _hodlr || _lowRank)
+                return;
+            if(!_ii || !_bb) {
+                std::cerr << "The matrices '_ii' and '_bb' have not been allocated => impossible to sample the Schur complement" << std::endl;
+                return;
+            }
+            const int n = Subdomain<K>::_dof;
+            const int block = std::min(n, std::max(k, 0) + 10);
+            int r = block;
+            K* const omega = new K[3 * block * n + block * std::max(block, _bi->_m) + 2 * block * block];
+            K* const y = omega + block * n;
+            K* const a = y + block * n;
+            K* const tmp = a + block * n;
+            K* const t = tmp + block * std::max(block, _bi->_m);
+            K* const h = t + block * block;
+            auto contribution = [&](K* const in, const int& m) {
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &n, &m, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &n, &(Wrapper<K>::d__0), tmp, &_bi->_m);
+                super::_s.solve(tmp, m);
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &n, &m, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), in, &n);
+            };
+            auto orthonormalize = [&]() {
+                int rank = 0;
+                for(int j = 0; j < r; ++j) {
+                    K* const v = omega + j * n;
+                    const typename Wrapper<K>::ul_type norm = Wrapper<K>::nrm2(&n, v, &i__1);
+                    for(unsigned short i = 0; i < 2 && rank > 0; ++i) {
+                        Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &rank, &(Wrapper<K>::d__1), omega, &n, v, &i__1, &(Wrapper<K>::d__0), tmp, &i__1);
+                        Wrapper<K>::gemv(&transa, &n, &rank, &(Wrapper<K>::d__2), omega, &n, tmp, &i__1, &(Wrapper<K>::d__1), v, &i__1);
+                    }
+                    const typename Wrapper<K>::ul_type remainder = Wrapper<K>::nrm2(&n, v, &i__1);
+                    if(remainder > HPDDM_EPS * norm) {
+                        const K scale = K(1.0) / remainder;
+                        Wrapper<K>::scal(&n, &scale, v, &i__1);
+                        if(rank != j)
+                            std::copy_n(v, n, omega + rank * n);
+                        ++rank;
+                    }
+                }
+                r = rank;
+            };
+            bool exact = n == 0 || _bi->_m == 0 || 2 * block > n;
+            if(!exact) {
+                // sparse factorization of bb, which preconditions the subspace iteration
+                MatrixCSR<K>* const bb = new MatrixCSR<K>(n, n, _bb->_nnz, true);
+                std::transform(_bb->_ia, _bb->_ia + n + 1, bb->_ia, [](int i) { return i - (Wrapper<K>::I == 'F'); });
+                std::transform(_bb->_ja, _bb->_ja + _bb->_nnz, bb->_ja, [](int i) { return i - (Wrapper<K>::I == 'F'); });
+                std::copy_n(_bb->_a, _bb->_nnz, bb->_a);
+                Solver<K> solver;
+                solver.numfact(bb);
+                std::mt19937 gen(_rankWorld);
+                std::normal_distribution<typename Wrapper<K>::ul_type> dist;
+                std::generate_n(omega, r * n, [&]() { return K(dist(gen)); });
+                orthonormalize();
+                std::vector<typename Wrapper<K>::ul_type> ritz, previous;
+                for(int solves = r; r > 0; solves += r) {
+                    std::copy_n(omega, r * n, y);
+                    contribution(y, r);
+                    // Rayleigh-Ritz projection of the Schur complement with the metric induced by bb
+                    Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &n, &r, &n, &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, omega, &_bb->_m, &(Wrapper<K>::d__0), a, &n);
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &r, &r, &n, &(Wrapper<K>::d__1), omega, &n, a, &n, &(Wrapper<K>::d__0), h, &r);
+                    std::copy_n(h, r * r, t);
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &r, &r, &n, &(Wrapper<K>::d__2), omega, &n, y, &n, &(Wrapper<K>::d__1), t, &r);
+                    std::copy_n(t, r * r, tmp);
+                    int nu = r;
+                    Lapack<K> evp(HPDDM_EPS, 0.0, r, nu);
+                    evp.reduce(t, h);
+                    int lwork = 64 * r;
+                    K* const work = new K[lwork + (std::is_same<K, typename Wrapper<K>::ul_type>::value ? 4 * r - 1 : 2 * r)];
+                    K** ev = nullptr;
+                    evp.solve(t, ev, work, lwork, Subdomain<K>::_communicator);
+                    delete [] work;
+                    nu = evp.getNu();
+                    if(nu == 0) {
+                        exact = true;
+                        break;
+                    }
+                    evp.expand(h, ev);
+                    Wrapper<K>::gemm(&transa, &transa, &r, &nu, &r, &(Wrapper<K>::d__1), tmp, &r, *ev, &r, &(Wrapper<K>::d__0), t, &r);
+                    ritz.resize(nu);
+                    for(int j = 0; j < nu; ++j)
+                        ritz[j] = Wrapper<K>::dot(&r, ev[j], &i__1, t + j * r, &i__1);
+                    delete [] *ev;
+                    delete [] ev;
+                    std::sort(ritz.begin(), ritz.end());
+                    if(ritz.size() == previous.size() && std::equal(ritz.cbegin(), ritz.cend(), previous.cbegin(), [](const typename Wrapper<K>::ul_type& lhs, const typename Wrapper<K>::ul_type& rhs) { return std::abs(lhs - rhs) <= 1.0e-2 * std::abs(lhs) + HPDDM_EPS; }))
+                        break;
+                    std::swap(ritz, previous);
+                    if(solves + r > n) {
+                        exact = true;
+                        break;
+                    }
+                    // one step of subspace iteration with the contribution preconditioned by bb
+                    std::copy_n(y, r * n, omega);
+                    solver.solve(omega, r);
+                    orthonormalize();
+                }
+                delete bb;
+                exact = exact || r == 0;
+            }
+            if(!exact) {
+                // shifted Nyström approximation W (Q^H W)^-1 W^H - s I of the contribution, with W = Y + s Q and Y the contribution applied to the orthonormal block Q
+                const int size = r * n;
+                const typename Wrapper<K>::ul_type shift = std::sqrt(n) * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() * Wrapper<K>::nrm2(&size, y, &i__1);
+                const K alpha = shift;
+                Wrapper<K>::axpy(&size, &alpha, omega, &i__1, y, &i__1);
+                Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &r, &r, &n, &(Wrapper<K>::d__1), omega, &n, y, &n, &(Wrapper<K>::d__0), h, &r);
+                int info;
+                Wrapper<K>::potrf(&uplo, &r, h, &r, &info);
+                exact = info != 0;
+                if(!exact) {
+                    _lowRank = new K[r * (n + r + 1)];
+                    std::copy_n(y, size, _lowRank);
+                    std::copy_n(h, r * r, _lowRank + size);
+                    _rank = r;
+                    _shift = shift;
+                }
+            }
+            if(exact) {
+                assembleSchurComplement();
+                for(int i = 0; i < n && _bi->_m > 0; i += block) {
+                    const int m = std::min(block, n - i);
+                    std::fill_n(omega, m * n, K());
+                    for(int j = 0; j < m; ++j)
+                        omega[i + j + j * n] = Wrapper<K>::d__1;
+                    contribution(omega, m);
+                    for(int j = 0; j < m; ++j)
+                        Wrapper<K>::axpy(&n, &(Wrapper<K>::d__2), omega + j * n, &i__1, _schur + (i + j) * n, &i__1);
+                }
+            }
+            delete [] omega;
+        }
         /* Function: callNumfactPreconditioner
          *  Factorizes <Schur::ii> if <Schur::schur> is not available. */
         inline void callNumfactPreconditioner() {
             if(_ii) {
-                if(!_schur)
+                if(!_schur && !_hodlr)
                     super::_s.numfact(_ii);
             }
             else
@@ -330,7 +568,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         }
         /* Function: renumber
          *
-         *  Renumbers <Subdomain::a> and <Preconditioner::ev> to easily assemble <Schur::bb>, <Schur::ii>, and <Schur::bi>.
+         *  Renumbers <Subdomain::a> and <Preconditioner::ev> to easily assemble <Schur::bb>, <Schur::ii>, and <Schur::bi>. The rows of <Subdomain::a> are split in as many blocks as there are OpenMP threads, and the three matrices are assembled in two passes over these blocks, a first one to count the nonzero entries of each row, and a second one to fill the preallocated arrays.
          *
          * Parameters:
          *    interface      - Numbering of the interface.
@@ -365,87 +603,121 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                     }
                     for(unsigned short l = 0; l < deflationBoundary.size(); ++l)
                         std::copy(deflationBoundary[l].cbegin(), deflationBoundary[l].cend(), super::_ev[l] + Subdomain<K>::_dof - interface.size());
-                    std::vector<std::pair<unsigned int, K>> tmpInterior;
-                    std::vector<std::pair<unsigned int, K>> tmpBoundary;
-                    std::vector<std::vector<std::pair<unsigned int, K>>> tmpInteraction(interface.size());
-                    tmpInterior.reserve(Subdomain<K>::_a->_nnz * (Subdomain<K>::_dof - interface.size()) / Subdomain<K>::_dof);
-                    tmpBoundary.reserve(Subdomain<K>::_a->_nnz * interface.size() / Subdomain<K>::_dof);
-                    for(i = 0; i < interface.size(); ++i)
-                        tmpInteraction[i].reserve(std::max(Subdomain<K>::_a->_ia[interface[i] + 1] - Subdomain<K>::_a->_ia[interface[i]] - 1, 0));
-                    _bb = new MatrixCSR<K, Wrapper<K>::I>(interface.size(), interface.size(), true);
-                    int* ii = new int[Subdomain<K>::_dof + 1];
-                    ii[0] = 0;
-                    _bb->_ia[0] = (Wrapper<K>::I == 'F');
-                    std::pair<std::vector<int>, std::vector<int>> boundaryCond;
-                    boundaryCond.first.reserve(Subdomain<K>::_dof - interface.size());
-                    boundaryCond.second.reserve(interface.size());
-                    for(i = 0; i < Subdomain<K>::_dof; ++i) {
-                        signed int row = vec[i];
-                        unsigned int stop;
-                        if(!Subdomain<K>::_a->_sym)
-                            stop = std::distance(Subdomain<K>::_a->_ja, std::upper_bound(Subdomain<K>::_a->_ja + Subdomain<K>::_a->_ia[i], Subdomain<K>::_a->_ja + Subdomain<K>::_a->_ia[i + 1], i));
-                        else
-                            stop = Subdomain<K>::_a->_ia[i + 1];
+                    const MatrixCSR<K>* const A = Subdomain<K>::_a;
+                    const unsigned int dof = interface.size();
+                    std::vector<char> boundaryCond(Subdomain<K>::_dof);
+#pragma omp parallel for schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY))
+                    for(int k = 0; k < Subdomain<K>::_dof; ++k) {
                         bool isBoundaryCond = true;
-                        for(j = Subdomain<K>::_a->_ia[i]; j < Subdomain<K>::_a->_ia[i + 1] && isBoundaryCond; ++j) {
-                            if(i != Subdomain<K>::_a->_ja[j] && std::abs(Subdomain<K>::_a->_a[j]) > HPDDM_EPS)
+                        for(int l = A->_ia[k]; l < A->_ia[k + 1] && isBoundaryCond; ++l) {
+                            if(k != A->_ja[l] && std::abs(A->_a[l]) > HPDDM_EPS)
                                 isBoundaryCond = false;
-                            else if(i == Subdomain<K>::_a->_ja[j] && std::abs(Subdomain<K>::_a->_a[j] - K(1.0)) > HPDDM_EPS)
+                            else if(k == A->_ja[l] && std::abs(A->_a[l] - K(1.0)) > HPDDM_EPS)
                                 isBoundaryCond = false;
                         }
-                        if(isBoundaryCond) {
-                            if(row > 0)
-                                boundaryCond.second.push_back(row);
-                            else
-                                boundaryCond.first.push_back(-row);
-                        }
-                        for(j = Subdomain<K>::_a->_ia[i]; j < stop; ++j) {
-                            const K val = Subdomain<K>::_a->_a[j];
-                            if(std::abs(val) > HPDDM_EPS) {
-                                const int col = vec[Subdomain<K>::_a->_ja[j]];
-                                if(col > 0) {
-                                    if(row < 0)
-                                        tmpInteraction[col - 1].emplace_back(-row - (Wrapper<K>::I != 'F'), val);
-                                    else if(col == row || !std::binary_search(boundaryCond.second.cbegin(), boundaryCond.second.cend(), col))
-                                        tmpBoundary.emplace_back(col - (Wrapper<K>::I != 'F'), val);
+                        boundaryCond[k] = isBoundaryCond;
+                    }
+#ifdef _OPENMP
+                    const int blocks = std::max(1, std::min(omp_get_max_threads(), static_cast<int>(Subdomain<K>::_dof)));
+#else
+                    const int blocks = 1;
+#endif
+                    std::vector<unsigned int> cursor((blocks + 1) * dof);
+                    _bb = new MatrixCSR<K, Wrapper<K>::I>(dof, dof, true);
+                    int* ii = new int[Subdomain<K>::_dof + 1];
+                    int* jaInterior = nullptr;
+                    K* aInterior = nullptr;
+                    for(unsigned short pass = 0; pass < 2; ++pass) {
+#pragma omp parallel for schedule(static, 1)
+                        for(int b = 0; b < blocks; ++b) {
+                            unsigned int* const transposed = cursor.data() + (b + 1) * dof;
+                            const unsigned int end = (static_cast<std::size_t>(b) + 1) * Subdomain<K>::_dof / blocks;
+                            for(unsigned int k = static_cast<std::size_t>(b) * Subdomain<K>::_dof / blocks; k < end; ++k) {
+                                const signed int row = vec[k];
+                                unsigned int stop;
+                                if(!A->_sym)
+                                    stop = std::distance(A->_ja, std::upper_bound(A->_ja + A->_ia[k], A->_ja + A->_ia[k + 1], k));
+                                else
+                                    stop = A->_ia[k + 1];
+                                unsigned int nnz = !pass ? 0 : (row < 0 ? ii[-row - 1] : _bb->_ia[row - 1] - (Wrapper<K>::I == 'F'));
+                                for(unsigned int l = A->_ia[k]; l < stop; ++l) {
+                                    const K val = A->_a[l];
+                                    if(std::abs(val) > HPDDM_EPS) {
+                                        const int col = vec[A->_ja[l]];
+                                        if(col > 0) {
+                                            if(row < 0) {
+                                                if(pass) {
+                                                    const unsigned int pos = transposed[col - 1]++;
+                                                    _bi->_ja[pos] = -row - (Wrapper<K>::I != 'F');
+                                                    _bi->_a[pos] = val;
+                                                }
+                                                else
+                                                    ++transposed[col - 1];
+                                            }
+                                            else if(col == row || !boundaryCond[A->_ja[l]]) {
+                                                if(pass) {
+                                                    _bb->_ja[nnz] = col - (Wrapper<K>::I != 'F');
+                                                    _bb->_a[nnz] = val;
+                                                }
+                                                ++nnz;
+                                            }
+                                        }
+                                        else if(col == row || !boundaryCond[A->_ja[l]]) {
+                                            if(row < 0) {
+                                                if(pass) {
+                                                    jaInterior[nnz] = -col - 1;
+                                                    aInterior[nnz] = val;
+                                                }
+                                                ++nnz;
+                                            }
+                                            else if(pass) {
+                                                const unsigned int pos = cursor[row - 1]++;
+                                                _bi->_ja[pos] = -col - (Wrapper<K>::I != 'F');
+                                                _bi->_a[pos] = val;
+                                            }
+                                            else
+                                                ++cursor[row - 1];
+                                        }
+                                    }
                                 }
-                                else if(col == row || !std::binary_search(boundaryCond.first.cbegin(), boundaryCond.first.cend(), -col)) {
+                                if(!pass) {
                                     if(row < 0)
-                                        tmpInterior.emplace_back(-col - 1, val);
+                                        ii[-row] = nnz;
                                     else
-                                        tmpInteraction[row - 1].emplace_back(-col - (Wrapper<K>::I != 'F'), val);
+                                        _bb->_ia[row] = nnz;
                                 }
                             }
                         }
-                        if(row < 0)
-                            ii[-row] = tmpInterior.size();
-                        else
-                            _bb->_ia[row] = tmpBoundary.size() + (Wrapper<K>::I == 'F');
-                    }
-                    for(i = 0; i < tmpInterior.size(); ++i) {
-                        Subdomain<K>::_a->_ja[i] = tmpInterior[i].first;
-                        Subdomain<K>::_a->_a[i] = tmpInterior[i].second;
-                    }
-                    for(i = 0, j = 0; i < tmpInteraction.size(); ++i) {
-                        std::sort(tmpInteraction[i].begin(), tmpInteraction[i].end(), [](const std::pair<unsigned int, K>& lhs, const std::pair<unsigned int, K>& rhs) { return lhs.first < rhs.first; });
-                        j += tmpInteraction[i].size();
-                    }
-                    _bi = new MatrixCSR<K, Wrapper<K>::I>(interface.size(), Subdomain<K>::_dof - interface.size(), j, false);
-                    _bi->_ia[0] = (Wrapper<K>::I == 'F');
-                    for(i = 0, j = 0; i < tmpInteraction.size(); ++i) {
-                        for(const std::pair<unsigned int, K>& p : tmpInteraction[i]) {
-                            _bi->_ja[j] = p.first;
-                            _bi->_a[j++] = p.second;
+                        if(!pass) {
+                            ii[0] = 0;
+                            for(i = 0; i < Subdomain<K>::_dof - dof; ++i)
+                                ii[i + 1] += ii[i];
+                            _bb->_ia[0] = (Wrapper<K>::I == 'F');
+                            for(i = 0; i < dof; ++i)
+                                _bb->_ia[i + 1] += _bb->_ia[i];
+                            _bb->_nnz = _bb->_ia[dof] - (Wrapper<K>::I == 'F');
+                            _bb->_a = new K[_bb->_nnz];
+                            _bb->_ja = new int[_bb->_nnz];
+                            jaInterior = new int[ii[Subdomain<K>::_dof - dof]];
+                            aInterior = new K[ii[Subdomain<K>::_dof - dof]];
+                            unsigned int nnz = 0;
+                            for(i = 0; i < dof; ++i) {
+                                for(int b = 0; b < blocks + 1; ++b) {
+                                    const unsigned int tmp = cursor[b * dof + i];
+                                    cursor[b * dof + i] = nnz;
+                                    nnz += tmp;
+                                }
+                            }
+                            _bi = new MatrixCSR<K, Wrapper<K>::I>(dof, Subdomain<K>::_dof - dof, nnz, false);
+                            for(i = 0; i < dof; ++i)
+                                _bi->_ia[i] = cursor[i] + (Wrapper<K>::I == 'F');
+                            _bi->_ia[dof] = nnz + (Wrapper<K>::I == 'F');
                         }
-                        _bi->_ia[i + 1] = j + (Wrapper<K>::I == 'F');
-                    }
-                    _bb->_nnz = tmpBoundary.size();
-                    _bb->_a = new K[_bb->_nnz];
-                    _bb->_ja = new int[_bb->_nnz];
-                    for(i = 0; i < tmpBoundary.size(); ++i) {
-                        _bb->_ja[i] = tmpBoundary[i].first;
-                        _bb->_a[i] = tmpBoundary[i].second;
                     }
+                    std::copy_n(jaInterior, ii[Subdomain<K>::_dof - dof], Subdomain<K>::_a->_ja);
+                    std::copy_n(aInterior, ii[Subdomain<K>::_dof - dof], Subdomain<K>::_a->_a);
+                    delete [] aInterior;
+                    delete [] jaInterior;
                     for(i = 0; i < _bb->_n; ++i) {
                         if(Wrapper<K>::I == 'F')
                             for(j = 0; j < _bi->_ia[i + 1] - _bi->_ia[i]; ++j)
@@ -516,29 +788,63 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         /* Function: getSigned
          *  Returns the value of <Schur::signed>. */
         inline unsigned short getSigned() const { return _signed; }
+        /* Function: getBuffer
+         *  Returns a pointer to the buffers for exchanging mu vectors allocated by <Schur::allocateBlock>, followed by a workspace of size <Schur::getWorkspace>. */
+        inline K* getBuffer(const unsigned short& mu) const {
+            return _structure + mu * (Subdomain<K>::_a->_n + Subdomain<K>::_dof);
+        }
+        /* Function: getWorkspace
+         *
+         *  Returns the number of scalars needed by <Schur::applyLocalSchurComplement(n)>, <Schur::applyLocalLumpedMatrix(n)>, and <Schur::applyLocalSuperlumpedMatrix(n)> as a workspace.
+         *
+         * Parameter:
+         *    n              - Number of input vectors. */
+        inline std::size_t getWorkspace(const int& n) const {
+            return static_cast<std::size_t>(n) * (Subdomain<K>::_dof + std::max(std::max(_bi->_m, _rank), _hodlr ? _hodlr->getMaxRank() : 0));
+        }
         /* Function: applyLocalSchurComplement(n)
          *
-         *  Applies the local Schur complement to multiple right-hand sides.
+         *  Applies the local Schur complement to multiple right-hand sides in-place.
          *
          * Parameters:
-         *    u              - Input vectors.
+         *    in             - Input vectors, overwritten by the output vectors.
          *    n              - Number of input vectors.
+         *    work           - Workspace array of size <Schur::getWorkspace> (optional, allocated if not supplied).
+         *
+         * Template Parameter:
+         *    exact          - True if the approximation computed by <Schur::sampleSchurComplement> must not be used, false otherwise.
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalSchurComplement(K*& in, const int& n) const {
-            K* out = new K[n * Subdomain<K>::_dof]();
-            if(!_schur) {
-                K* tmp = new K[n * _bi->_m];
+        template<bool exact = false>
+        inline void applyLocalSchurComplement(K* const in, const int& n, K* work = nullptr) const {
+            const bool allocate = !work;
+            if(allocate)
+                work = new K[getWorkspace(n)];
+            if(_hodlr)
+                _hodlr->apply(in, work, n, work + n * Subdomain<K>::_dof);
+            else if(_lowRank && !exact) {
+                K* const tmp = work + n * Subdomain<K>::_dof;
+                const int size = n * Subdomain<K>::_dof;
+                const K shift = _shift;
+                int info;
+                Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &_rank, &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _lowRank, &(Subdomain<K>::_dof), in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &_rank);
+                Wrapper<K>::potrs(&uplo, &_rank, &n, _lowRank + _rank * Subdomain<K>::_dof, &_rank, tmp, &_rank, &info);
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &_bb->_m, &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                Wrapper<K>::axpy(&size, &shift, in, &i__1, work, &i__1);
+                Wrapper<K>::gemm(&transa, &transa, &(Subdomain<K>::_dof), &n, &_rank, &(Wrapper<K>::d__2), _lowRank, &(Subdomain<K>::_dof), tmp, &_rank, &(Wrapper<K>::d__1), work, &(Subdomain<K>::_dof));
+            }
+            else if(!_schur) {
+                K* const tmp = work + n * Subdomain<K>::_dof;
                 Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &_bi->_m);
                 super::_s.solve(tmp, n);
-                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
-                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &_bb->_m, &(Wrapper<K>::d__2), out, &(Subdomain<K>::_dof));
-                delete [] tmp;
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &_bb->_m, &(Wrapper<K>::d__2), work, &(Subdomain<K>::_dof));
             }
             else
-                Wrapper<K>::symm(&uplo, &uplo, &(Subdomain<K>::_dof), &n, &(Wrapper<K>::d__1), _schur, &(Subdomain<K>::_dof), in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
-            delete [] in;
-            in = out;
+                Wrapper<K>::symm(&uplo, &uplo, &(Subdomain<K>::_dof), &n, &(Wrapper<K>::d__1), _schur, &(Subdomain<K>::_dof), in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+            std::copy_n(work, n * Subdomain<K>::_dof, in);
+            if(allocate)
+                delete [] work;
         }
         /* Function: applyLocalSchurComplement
          *
@@ -548,9 +854,31 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    in             - Input vector.
          *    out            - Output vector (optional).
          *
+         * Template Parameter:
+         *    exact          - True if the approximation computed by <Schur::sampleSchurComplement> must not be used, false otherwise.
+         *
          * See also: <Feti::applyLocalPreconditioner> and <Bdd::apply>. */
+        template<bool exact = false>
         inline void applyLocalSchurComplement(K* const in, K* const& out = nullptr) const {
-            if(!_schur) {
+            if(_hodlr) {
+                _hodlr->apply(in, out ? out : _work + _bi->_m, 1);
+                if(!out)
+                    std::copy_n(_work + _bi->_m, Subdomain<K>::_dof, in);
+            }
+            else if(_lowRank && !exact) {
+                K* const pt = out ? out : _work + _bi->_m;
+                K* const tmp = _lowRank + _rank * (Subdomain<K>::_dof + _rank);
+                const K shift = _shift;
+                int info;
+                Wrapper<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), &_rank, &(Wrapper<K>::d__1), _lowRank, &(Subdomain<K>::_dof), in, &i__1, &(Wrapper<K>::d__0), tmp, &i__1);
+                Wrapper<K>::potrs(&uplo, &_rank, &i__1, _lowRank + _rank * Subdomain<K>::_dof, &_rank, tmp, &_rank, &info);
+                Wrapper<K>::template csrmv<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &(Wrapper<K>::d__0), pt);
+                Wrapper<K>::axpy(&(Subdomain<K>::_dof), &shift, in, &i__1, pt, &i__1);
+                Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), &_rank, &(Wrapper<K>::d__2), _lowRank, &(Subdomain<K>::_dof), tmp, &i__1, &(Wrapper<K>::d__1), pt, &i__1);
+                if(!out)
+                    std::copy_n(pt, Subdomain<K>::_dof, in);
+            }
+            else if(!_schur) {
                 Wrapper<K>::template csrmv<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &(Wrapper<K>::d__0), _work);
                 super::_s.solve(_work);
                 if(out) {
@@ -572,18 +900,22 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         }
         /* Function: applyLocalLumpedMatrix(n)
          *
-         *  Applies the local lumped matrix <Schur::bb> to multiple right-hand sides.
+         *  Applies the local lumped matrix <Schur::bb> to multiple right-hand sides in-place.
          *
          * Parameters:
-         *    u              - Input vectors.
+         *    in             - Input vectors, overwritten by the output vectors.
          *    n              - Number of input vectors.
+         *    work           - Workspace array of size <Schur::getWorkspace> (optional, allocated if not supplied).
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalLumpedMatrix(K*& in, const int& n) const {
-            K* out = new K[n * Subdomain<K>::_dof];
-            Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
-            delete [] in;
-            in = out;
+        inline void applyLocalLumpedMatrix(K* const in, const int& n, K* work = nullptr) const {
+            const bool allocate = !work;
+            if(allocate)
+                work = new K[n * Subdomain<K>::_dof];
+            Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+            std::copy_n(work, n * Subdomain<K>::_dof, in);
+            if(allocate)
+                delete [] work;
         }
         /* Function: applyLocalLumpedMatrix
          *
@@ -600,19 +932,28 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
         }
         /* Function: applyLocalSuperlumpedMatrix(n)
          *
-         *  Applies the local superlumped matrix diag(<Schur::bb>) to multiple right-hand sides.
+         *  Applies the local superlumped matrix diag(<Schur::bb>) to multiple right-hand sides in-place. The diagonal is first gathered in a contiguous array so that each right-hand side is scaled with unit stride.
          *
          * Parameters:
-         *    u              - Input vectors.
+         *    in             - Input vectors, overwritten by the output vectors.
          *    n              - Number of input vectors.
+         *    work           - Workspace array of size <Schur::getWorkspace> (optional, allocated if not supplied).
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalSuperlumpedMatrix(K*& in, const int& n) const {
-            for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i) {
-                K d = _bb->_a[_bb->_ia[i + 1] - (Wrapper<K>::I == 'F' ? 2 : 1)];
-                for(int j = 0; j < n; ++j)
-                    in[i + j * Subdomain<K>::_dof] *= d;
+        inline void applyLocalSuperlumpedMatrix(K* const in, const int& n, K* work = nullptr) const {
+            const bool allocate = !work;
+            if(allocate)
+                work = new K[Subdomain<K>::_dof];
+            for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                work[i] = _bb->_a[_bb->_ia[i + 1] - (Wrapper<K>::I == 'F' ? 2 : 1)];
+            for(int j = 0; j < n; ++j) {
+                K* const pt = in + j * Subdomain<K>::_dof;
+#pragma omp simd
+                for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                    pt[i] *= work[i];
             }
+            if(allocate)
+                delete [] work;
         }
         /* Function: applyLocalSuperlumpedMatrix
          *
@@ -627,13 +968,42 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i)
                 in[i] *= _bb->_a[_bb->_ia[i + 1] - (Wrapper<K>::I == 'F' ? 2 : 1)];
         }
+        /* Function: compressVectors
+         *
+         *  Compresses the restriction of the deflation vectors to the interface by calling <Preconditioner::compressVectors>. This must be called after <Feti::buildTwo> or <Bdd::buildTwo>, and the dense vectors are kept for <Feti::computeSolution> and <Bdd::computeSolution>.
+         *
+         * Parameter:
+         *    threshold      - Drop tolerance (optional). */
+        inline bool compressVectors(const typename Wrapper<K>::ul_type& threshold = HPDDM_EPS) {
+            return super::compressVectors(threshold, Subdomain<K>::_dof, _schur || _hodlr || _lowRank ? 0 : _bi->_m, _schur || _hodlr || _lowRank ? Subdomain<K>::_dof : Subdomain<K>::_a->_n);
+        }
+        /* Function: compressSchurComplement
+         *
+         *  Replaces the explicit local Schur complement <Schur::schur> by a compressed representation <Schur::hodlr>. This must be called after <Feti::solveGEVP> or <Bdd::solveGEVP>, which need <Schur::schur>. Small interfaces are kept dense, and the compressed representation is only kept, and true is returned, if it requires less memory than <Schur::schur>.
+         *
+         * Parameters:
+         *    eps            - Relative accuracy of the low-rank approximations (optional).
+         *    leaf           - Maximum size of the dense diagonal blocks (optional). */
+        inline bool compressSchurComplement(const typename Wrapper<K>::ul_type& eps = 1.0e-8, const int& leaf = 256) {
+            if(!_schur || Subdomain<K>::_dof <= 2 * leaf)
+                return false;
+            _hodlr = new Hodlr<K>(_schur, Subdomain<K>::_dof, eps, leaf);
+            if(_hodlr->getSize() >= static_cast<std::size_t>(Subdomain<K>::_dof) * Subdomain<K>::_dof) {
+                delete _hodlr;
+                _hodlr = nullptr;
+                return false;
+            }
+            delete [] _schur;
+            _schur = nullptr;
+            return true;
+        }
         /* Function: getRank
          *  Returns the value of <Schur::rankWorld>. */
         inline int getRank() const { return _rankWorld; }
         /* Function: getLDR
          *  Returns the address of the leading dimension of <Preconditioner::ev>. */
         inline const int* getLDR() const {
-            return _schur ? &_bi->_n : &(super::_a->_n);
+            return _schur || _hodlr || _lowRank ? &_bi->_n : &(super::_a->_n);
         }
         /* Function: getEliminated
          *  Returns the number of eliminated unknowns of <Subdomain<K>::a>, i.e. the number of columns of <Schur::bi>. */
@@ -646,11 +1016,27 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *
          * Parameters:
          *    f              - Input right-hand side.
-         *    b              - Condensed right-hand side. */
-        inline void condensateEffort(const K* const f, K* const b) const {
-            super::_s.solve(f, _structure);
-            std::copy_n(f + _bi->_m, Subdomain<K>::_dof, b ? b : _structure + _bi->_m);
-            Wrapper<K>::template csrmv<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__2), false, _bi->_a, _bi->_ia, _bi->_ja, _structure, &(Wrapper<K>::d__1), b ? b : _structure + _bi->_m);
+         *    b              - Condensed right-hand side.
+         *    mu             - Number of right-hand sides (optional), the condensed right-hand sides are stored in <Schur::structure> with a leading dimension equal to the size of <Subdomain::a> if b is not supplied. */
+        inline void condensateEffort(const K* const f, K* const b, const unsigned short& mu = 1) const {
+            if(mu == 1) {
+                super::_s.solve(f, _structure);
+                std::copy_n(f + _bi->_m, Subdomain<K>::_dof, b ? b : _structure + _bi->_m);
+                Wrapper<K>::template csrmv<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &_bi->_m, &(Wrapper<K>::d__2), false, _bi->_a, _bi->_ia, _bi->_ja, _structure, &(Wrapper<K>::d__1), b ? b : _structure + _bi->_m);
+            }
+            else {
+                K* const work = getBuffer(mu) + 2 * mu * _mult;
+                K* const tmp = work + mu * Subdomain<K>::_dof;
+                const int n = mu;
+                const int ld = b ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                for(unsigned short j = 0; j < mu; ++j)
+                    std::copy_n(f + j * Subdomain<K>::_a->_n, _bi->_m, tmp + j * _bi->_m);
+                super::_s.solve(tmp, mu);
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__2), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                for(unsigned short j = 0; j < mu; ++j)
+                    Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), f + j * Subdomain<K>::_a->_n + _bi->_m, &i__1, work + j * Subdomain<K>::_dof, &i__1);
+                Wrapper<K>::lacpy("A", &(Subdomain<K>::_dof), &n, work, &(Subdomain<K>::_dof), b ? b : _structure + _bi->_m, &ld);
+            }
         }
         /* Function: computeError
          *
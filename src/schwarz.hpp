@@ -59,13 +59,21 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         /* Variable: type
          *  Type of <Prcndtnr> used in <Schwarz::apply> and <Schwarz::deflation>. */
         Prcndtnr                         _type;
-#if HPDDM_GMV
+        /* Variable: async
+         *  True if the coarse corrections in <Schwarz::apply> are computed with nonblocking MPI collective operations, false otherwise. */
+        bool                            _async;
+        /* Variable: work
+         *  Workspace array for the nonblocking coarse corrections of the balanced variants in <Schwarz::apply>. */
+        mutable K*                       _work;
+        /* Variable: map
+         *  Indices of the values sent to and received from each neighbor in <Schwarz::optimized_exchange>, only used if the runtime option gmv is set. */
         std::vector<std::pair<std::vector<int>,
                     std::vector<int>>>    _map;
-#endif
     public:
-        Schwarz() : _d() { }
-        ~Schwarz() { }
+        Schwarz() : _d(), _async(Option::get().val<bool>("async", HPDDM_ICOLLECTIVE)), _work() { }
+        ~Schwarz() {
+            delete [] _work;
+        }
         /* Typedef: super
          *  Type of the immediate parent class <Preconditioner>. */
         typedef Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>, K> super;
@@ -74,20 +82,21 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         template<class Container = std::vector<int>>
         inline void initialize(typename Wrapper<K>::ul_type* const& d) {
             _d = d;
-#if HPDDM_GMV
-            _map.resize(Subdomain<K>::_map.size());
-            for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
-                _map[i].first.reserve(Subdomain<K>::_map[i].second.size());
-                _map[i].second.reserve(Subdomain<K>::_map[i].second.size());
-                for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j) {
-                    const unsigned int k = Subdomain<K>::_map[i].second[j];
-                    if(std::abs(_d[k] - 1.0) < HPDDM_EPS)
-                        _map[i].first.emplace_back(k);
-                    else if(std::abs(_d[k]) < HPDDM_EPS)
-                        _map[i].second.emplace_back(k);
+            _map.clear();
+            if(Option::get().val<bool>("gmv", HPDDM_GMV)) {
+                _map.resize(Subdomain<K>::_map.size());
+                for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
+                    _map[i].first.reserve(Subdomain<K>::_map[i].second.size());
+                    _map[i].second.reserve(Subdomain<K>::_map[i].second.size());
+                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j) {
+                        const unsigned int k = Subdomain<K>::_map[i].second[j];
+                        if(std::abs(_d[k] - 1.0) < HPDDM_EPS)
+                            _map[i].first.emplace_back(k);
+                        else if(std::abs(_d[k]) < HPDDM_EPS)
+                            _map[i].second.emplace_back(k);
+                    }
                 }
             }
-#endif
         }
         /* Function: setType
          *  Sets <Schwarz::type>. */
@@ -97,6 +106,11 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         inline void setType(Prcndtnr t) {
             _type = t;
         }
+        /* Function: setAsynchronous
+         *  Sets <Schwarz::async>. This has no effect if the MPI implementation does not support nonblocking collective operations. */
+        inline void setAsynchronous(bool async) {
+            _async = async;
+        }
         /* Function: callNumfact
          *  Factorizes <Subdomain::a> or another user-supplied matrix, useful for <Prcndtnr::OS> and <Prcndtnr::OG>. */
         inline void callNumfact(MatrixCSR<K>* const& A = nullptr) {
@@ -161,9 +175,15 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 super::_co->template callSolver<excluded>(super::_uc, fuse);
             else {
                 Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in, out);                                                                                                                                                 // out = D in
-                Wrapper<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1); // _uc = _ev^T D in
-                super::_co->template callSolver<excluded>(super::_uc, fuse);                                                                                                                                        // _uc = E \ _ev^T D in
-                Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), out, &i__1);               // out = _ev E \ _ev^T D in
+                if(super::_evc)
+                    super::template applyVectors<'C'>(out, super::_uc);
+                else
+                    Wrapper<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1); // _uc = _ev^T D in
+                super::_co->template callSolver<excluded>(super::_uc, fuse);                                                                                                                                            // _uc = E \ _ev^T D in
+                if(super::_evc)
+                    super::template applyVectors<'N'>(super::_uc, out);
+                else
+                    Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), out, &i__1);               // out = _ev E \ _ev^T D in
                 if(_type != Prcndtnr::AD) {
                     Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
                     Subdomain<K>::exchange(out);
@@ -172,10 +192,10 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             if(fuse > 0)
                 std::copy(super::_uc + super::getLocal(), super::_uc + super::getLocal() + fuse, out + Subdomain<K>::_dof);
         }
-#if HPDDM_ICOLLECTIVE
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
         /* Function: Ideflation
          *
-         *  Computes the first part of a coarse correction asynchronously.
+         *  Computes the first part of a coarse correction asynchronously. Once both requests have completed, the solution of the coarse system is stored in <Preconditioner::uc> (and the fused reductions in <Preconditioner::uc> as well, after <Coarse operator::local> values).
          *
          * Template parameter:
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise. 
@@ -195,13 +215,14 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 super::_co->template IcallSolver<excluded>(super::_uc, rq, fuse);
             else {
                 Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in, out);
-                Wrapper<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
+                if(super::_evc)
+                    super::template applyVectors<'C'>(out, super::_uc);
+                else
+                    Wrapper<K>::gemv(&(Wrapper<K>::transc), &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), out, &i__1, &(Wrapper<K>::d__0), super::_uc, &i__1);
                 super::_co->template IcallSolver<excluded>(super::_uc, rq, fuse);
             }
-            if(fuse > 0)
-                std::copy(super::_uc + super::getLocal(), super::_uc + super::getLocal() + fuse, out + Subdomain<K>::_dof);
         }
-#endif // HPDDM_ICOLLECTIVE
+#endif
         template<bool excluded>
         inline void deflation(K* const out, const unsigned short& fuse = 0) const {
             deflation<excluded>(nullptr, out, fuse);
@@ -224,6 +245,40 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             auto ret = super::template buildTwo<excluded, 2>(A, comm, parm);
             return ret;
         }
+        /* Function: compressVectors
+         *
+         *  Compresses the deflation vectors by calling <Preconditioner::compressVectors>, and optionally releases the dense ones. This must be called after <Schwarz::buildTwo>, and the dense vectors are needed again for subsequent calls to <Schwarz::buildTwo>.
+         *
+         * Parameters:
+         *    threshold      - Drop tolerance (optional).
+         *    release        - True if <Preconditioner::ev> should be freed after a successful compression, false otherwise (optional). */
+        inline bool compressVectors(const typename Wrapper<K>::ul_type& threshold = HPDDM_EPS, const bool release = false) {
+            bool compressed = super::compressVectors(threshold, Subdomain<K>::_dof);
+            if(compressed && release) {
+                delete [] *super::_ev;
+                delete []  super::_ev;
+                super::_ev = nullptr;
+            }
+            return compressed;
+        }
+        /* Function: balanced
+         *
+         *  Computes the local part of the balanced variants of <Schwarz::apply>, once the coarse correction is known.
+         *
+         * Parameters:
+         *    in             - Input vector, modified internally !
+         *    out            - Coarse correction on input, output vector on output. */
+        inline void balanced(K* const in, K* const out) const {
+            Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), in);
+            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+            Subdomain<K>::exchange(in);                                                          //  in = (I - A Z E \ Z^T) in
+            if(_type == Prcndtnr::OS)
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+            super::_s.solve(in);
+            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+            Subdomain<K>::exchange(in);                                                          //  in = D A \ (I - A Z E \ Z^T) in
+            Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
+        }
         /* Function: apply
          *
          *  Applies the global Schwarz preconditioner.
@@ -255,21 +310,53 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 }
             }
             else {
-                if(_type == Prcndtnr::AD) {
-#if HPDDM_ICOLLECTIVE
-                    MPI_Request rq[2];
-                    Ideflation<excluded>(in, out, rq, fuse);
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                if(_async) {
+                    MPI_Request rq[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+                    Ideflation<excluded>(in, out, rq, fuse);                                                 // _uc = E \ Z^T D in, posted
                     if(!excluded) {
-                        super::_s.solve(in);                                                                                                                                                                  // out = A \ in
-                        MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
-                        Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), out, &i__1); // out = Z E \ Z^T in
-                        Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);
-                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
-                        Subdomain<K>::exchange(out);                                                                                                                                                          // out = Z E \ Z^T in + A \ in
+                        if(_type == Prcndtnr::AD) {
+                            super::_s.solve(in);                                                             //  in = A \ in, overlapped with the coarse solve
+                            MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
+                            if(super::_evc)
+                                super::template applyVectors<'N'>(super::_uc, out);
+                            else
+                                Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), out, &i__1); // out = Z E \ Z^T D in
+                            Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                            Subdomain<K>::exchange(out);
+                        }
+                        else {
+                            if(!_work)
+                                _work = new K[Subdomain<K>::_dof];
+                            Subdomain<K>::exchange(out);                                                     // out = D in, overlapped with the coarse solve
+                            MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
+                            if(super::_evc)
+                                super::template applyVectors<'N'>(super::_uc, in);
+                            else
+                                Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), in, &i__1);
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+                            Subdomain<K>::exchange(in);                                                      //  in = Z E \ Z^T D in
+                            Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, &(Wrapper<K>::d__0), _work);
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, _work);
+                            Subdomain<K>::exchange(_work);
+                            Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), _work, &i__1, out, &i__1); // out = D (I - A Z E \ Z^T) in
+                            if(_type == Prcndtnr::OS)
+                                Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                            super::_s.solve(out);
+                            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                            Subdomain<K>::exchange(out);
+                            Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
+                        }
                     }
                     else
-                        MPI_Wait(rq + 1, MPI_STATUS_IGNORE);
-#else
+                        MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
+                    if(fuse > 0)
+                        std::copy(super::_uc + super::getLocal(), super::_uc + super::getLocal() + fuse, out + Subdomain<K>::_dof);
+                    return;
+                }
+#endif
+                if(_type == Prcndtnr::AD) {
                     deflation<excluded>(in, out, fuse);
                     if(!excluded) {
                         super::_s.solve(in);
@@ -277,21 +364,11 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
                         Subdomain<K>::exchange(out);
                     }
-#endif // HPDDM_ICOLLECTIVE
                 }
                 else {
                     deflation<excluded>(in, out, fuse);                                                      // out = Z E \ Z^T in
-                    if(!excluded) {
-                        Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), in);
-                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
-                        Subdomain<K>::exchange(in);                                                          //  in = (I - A Z E \ Z^T) in
-                        if(_type == Prcndtnr::OS)
-                            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
-                        super::_s.solve(in);
-                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
-                        Subdomain<K>::exchange(in);                                                          //  in = D A \ (I - A Z E \ Z^T) in
-                        Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
-                    }
+                    if(!excluded)
+                        balanced(in, out);
                 }
             }
         }
@@ -312,7 +389,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                         intoOverlap.insert(i);
             std::vector<std::vector<std::pair<unsigned int, K>>> tmp(intoOverlap.size());
             unsigned int k, iPrev = 0;
-#pragma omp parallel for schedule(static, HPDDM_GRANULARITY) reduction(+ : iPrev)
+#pragma omp parallel for schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY)) reduction(+ : iPrev)
             for(k = 0; k < intoOverlap.size(); ++k) {
                 auto it = intoOverlap.begin();
                 std::advance(it, k);
@@ -348,9 +425,12 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          *    A              - Left-hand side matrix.
          *    B              - Right-hand side matrix (optional).
          *    nu             - Number of eigenvectors requested.
-         *    threshold      - Precision of the eigensolver. */
+         *    threshold      - Precision of the eigensolver.
+         *    pattern        - Sparsity pattern of the local matrix (optional).
+         *    recycle        - True if the deflation vectors from a previous call, with the same local numbering, should be used to warm-start the eigensolver, false otherwise. */
         template<template<class> class Eps>
-        inline void solveGEVP(MatrixCSR<K>* const& A, unsigned short& nu, const typename Wrapper<K>::ul_type& threshold, MatrixCSR<K>* const& B = nullptr, const MatrixCSR<K>* const& pattern = nullptr) {
+        inline void solveGEVP(MatrixCSR<K>* const& A, unsigned short& nu, const typename Wrapper<K>::ul_type& threshold, MatrixCSR<K>* const& B = nullptr, const MatrixCSR<K>* const& pattern = nullptr, const bool recycle = false) {
+            const unsigned short warm = recycle && super::_ev ? std::min(super::getLocal(), nu) : 0;
             Eps<K> evp(threshold, Subdomain<K>::_dof, nu);
             bool free = pattern ? pattern->sameSparsity(A) : Subdomain<K>::_a->sameSparsity(A);
             MatrixCSR<K>* rhs = nullptr;
@@ -358,7 +438,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                 rhs = B;
             else
                 scaleIntoOverlap(A, rhs);
-            evp.template solve<Solver>(A, rhs, super::_ev, Subdomain<K>::_communicator, free ? &(super::_s) : nullptr);
+            evp.template solve<Solver>(A, rhs, super::_ev, Subdomain<K>::_communicator, free ? &(super::_s) : nullptr, warm);
             if(rhs != B)
                 delete rhs;
             if(free) {
@@ -367,7 +447,8 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             }
             nu = evp.getNu();
         }
-#if HPDDM_GMV
+        /* Function: optimized_exchange
+         *  Exchanges values between neighbors using <Schwarz::map>. */
         inline void optimized_exchange(K* const out) const {
             for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i) {
                 MPI_Irecv(Subdomain<K>::_rbuff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 1, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
@@ -381,7 +462,6 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             }
             MPI_Waitall(Subdomain<K>::_map.size(), Subdomain<K>::_rq + Subdomain<K>::_map.size(), MPI_STATUSES_IGNORE);
         }
-#endif
         /* Function: GMV
          *
          *  Computes a global sparse matrix-vector product.
@@ -398,12 +478,12 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             Subdomain<K>::exchange(out);
 #else
             Wrapper<K>::template csrmv<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
-#if HPDDM_GMV
-            optimized_exchange(out);
-#else
-            Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
-            Subdomain<K>::exchange(out);
-#endif
+            if(!_map.empty())
+                optimized_exchange(out);
+            else {
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                Subdomain<K>::exchange(out);
+            }
 #endif
         }
         /* Function: computeError
@@ -28,9 +28,10 @@ namespace HPDDM {
  *
  *  A class for handling all communications and computations between subdomains.
  *
- * Template Parameter:
- *    K              - Scalar type. */
-template<class K>
+ * Template Parameters:
+ *    K              - Scalar type.
+ *    I              - Integer type of the row pointers and column indices of the local matrix. */
+template<class K, class I = int>
 class Subdomain {
     protected:
         /* Variable: rbuff
@@ -52,7 +53,7 @@ class Subdomain {
         vectorNeighbor             _map;
         /* Variable: a
          *  Local matrix. */
-        MatrixCSR<K>*                _a;
+        MatrixCSR<K, 'C', I>*        _a;
     public:
         Subdomain() : _rq(), _map(), _a() { }
         ~Subdomain() {
@@ -87,6 +88,38 @@ class Subdomain {
             }
             MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
         }
+        /* Function: exchange(mu)
+         *
+         *  Exchanges and reduces values of duplicated unknowns of multiple vectors, using a single message per neighboring subdomain.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    mu             - Number of vectors.
+         *    ld             - Leading dimension of the input vectors.
+         *    buffer         - Workspace array of size twice mu times the number of duplicated unknowns. */
+        inline void exchange(K* const in, const unsigned short& mu, const int& ld, K* const buffer) const {
+            if(mu == 1) {
+                exchange(in);
+                return;
+            }
+            unsigned int size = 0;
+            for(const pairNeighbor& neighbor : _map)
+                size += neighbor.second.size();
+            K* const recv = buffer + mu * size;
+            unsigned int offset = 0;
+            for(unsigned short i = 0; i < _map.size(); offset += mu * _map[i++].second.size()) {
+                MPI_Irecv(recv + offset, mu * _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
+                for(unsigned short j = 0; j < mu; ++j)
+                    Wrapper<K>::gthr(_map[i].second.size(), in + j * ld, buffer + offset + j * _map[i].second.size(), _map[i].second.data());
+                MPI_Isend(buffer + offset, mu * _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + _map.size() + i);
+            }
+            MPI_Waitall(2 * _map.size(), _rq, MPI_STATUSES_IGNORE);
+            offset = 0;
+            for(unsigned short i = 0; i < _map.size(); offset += mu * _map[i++].second.size())
+                for(unsigned short j = 0; j < mu; ++j)
+                    for(unsigned int k = 0; k < _map[i].second.size(); ++k)
+                        in[j * ld + _map[i].second[k]] += recv[offset + j * _map[i].second.size() + k];
+        }
         /* Function: recvBuffer
          *
          *  Exchanges values of duplicated unknowns.
@@ -115,7 +148,7 @@ class Subdomain {
          *    end            - Iterator pointing to the past-the-end element of the container of indices of neighboring subdomains.
          *    comm           - MPI communicator of the domain decomposition. */
         template<class It, class Container>
-        inline void initialize(MatrixCSR<K>* const& a, const It& begin, const It& end, std::vector<Container*> const& r, MPI_Comm* const& comm = nullptr) {
+        inline void initialize(MatrixCSR<K, 'C', I>* const& a, const It& begin, const It& end, std::vector<Container*> const& r, MPI_Comm* const& comm = nullptr) {
             if(comm)
                 _communicator = *comm;
             else
@@ -174,7 +207,7 @@ class Subdomain {
         inline int getDof() const { return _dof; }
         /* Function: getMatrix
          *  Returns a constant pointer to <Subdomain::a>. */
-        inline const MatrixCSR<K>* getMatrix() const { return _a; }
+        inline const MatrixCSR<K, 'C', I>* getMatrix() const { return _a; }
         /* Function: globalMapping
          *
          *  Computes a global numbering of all unknowns.
@@ -296,9 +329,9 @@ class Subdomain {
          *  Assembles a distributed matrix that can by used by a backend such as PETSc.
          *
          * See also: <Subdomain::globalMapping>. */
-        inline bool distributedCSR(unsigned int* num, unsigned int first, unsigned int last, int*& ia, int*& ja, K*& c, const MatrixCSR<K>* const& A) const {
+        inline bool distributedCSR(unsigned int* num, unsigned int first, unsigned int last, I*& ia, I*& ja, K*& c, const MatrixCSR<K, 'C', I>* const& A) const {
             if(first != 0 || last != A->_n) {
-                unsigned int nnz = 0;
+                I nnz = 0;
                 unsigned int dof = 0;
                 for(unsigned int i = 0; i < A->_n; ++i) {
                     if(num[i] >= first && num[i] < last)
@@ -312,7 +345,7 @@ class Subdomain {
                 nnz = 0;
                 for(unsigned int i = 0; i < A->_n; ++i) {
                     if(num[i] >= first && num[i] < last) {
-                        for(unsigned int j = A->_ia[i]; j < A->_ia[i + 1]; ++j)
+                        for(I j = A->_ia[i]; j < A->_ia[i + 1]; ++j)
                             tmp[num[i] - first].emplace_back(num[A->_ja[j]], A->_a[j]);
                     }
                 }
@@ -321,9 +354,9 @@ class Subdomain {
                 if(!c)
                     c  = new K[nnz];
                 if(!ia)
-                    ia = new int[dof + 1];
+                    ia = new I[dof + 1];
                 if(!ja)
-                    ja = new int[nnz];
+                    ja = new I[nnz];
                 ia[0] = 0;
                 nnz = 0;
                 for(unsigned int i = 0; i < dof; ++i) {
@@ -81,6 +81,24 @@ class Wrapper {
         /* Function: lacpy
          *  Copies all or part of a two-dimensional matrix. */
         static inline void lacpy(const char* const, const int* const, const int* const, const K* const, const int* const, K* const, const int* const);
+        /* Function: getrf
+         *  Computes the LU factorization of a general matrix. */
+        static inline void getrf(const int* const, const int* const, K* const, const int* const, int* const, int* const);
+        /* Function: getrs
+         *  Solves a system of linear equations with an LU-factored matrix. */
+        static inline void getrs(const char* const, const int* const, const int* const, const K* const, const int* const, const int* const, K* const, const int* const, int* const);
+        /* Function: potrf
+         *  Computes the Cholesky factorization of a symmetric or Hermitian positive definite matrix. */
+        static inline void potrf(const char* const, const int* const, K* const, const int* const, int* const);
+        /* Function: potrs
+         *  Solves a system of linear equations with a Cholesky-factored matrix. */
+        static inline void potrs(const char* const, const int* const, const int* const, const K* const, const int* const, K* const, const int* const, int* const);
+        /* Function: sytrf
+         *  Computes the Bunch-Kaufman factorization of a symmetric matrix. */
+        static inline void sytrf(const char* const, const int* const, K* const, const int* const, int* const, K* const, const int* const, int* const);
+        /* Function: sytrs
+         *  Solves a system of linear equations with a Bunch-Kaufman-factored symmetric matrix. */
+        static inline void sytrs(const char* const, const int* const, const int* const, const K* const, const int* const, const int* const, K* const, const int* const, int* const);
 
         /* Function: symv
          *  Computes a symmetric scalar-matrix-vector product. */
@@ -177,6 +195,39 @@ template<>
 inline void Wrapper<T>::lacpy(const char* const uplo, const int* const m, const int* const n,                \
                               const T* const a, const int* const lda, T* const b, const int* const ldb) {    \
     HPDDM_F77(C ## lacpy)(uplo, m, n, a, lda, b, ldb);                                                       \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::getrf(const int* const m, const int* const n, T* const a, const int* const lda,      \
+                              int* const ipiv, int* const info) {                                            \
+    HPDDM_F77(C ## getrf)(m, n, a, lda, ipiv, info);                                                         \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::getrs(const char* const trans, const int* const n, const int* const nrhs,            \
+                              const T* const a, const int* const lda, const int* const ipiv, T* const b,     \
+                              const int* const ldb, int* const info) {                                       \
+    HPDDM_F77(C ## getrs)(trans, n, nrhs, a, lda, ipiv, b, ldb, info);                                       \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::potrf(const char* const uplo, const int* const n, T* const a, const int* const lda,  \
+                              int* const info) {                                                             \
+    HPDDM_F77(C ## potrf)(uplo, n, a, lda, info);                                                            \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::potrs(const char* const uplo, const int* const n, const int* const nrhs,             \
+                              const T* const a, const int* const lda, T* const b, const int* const ldb,      \
+                              int* const info) {                                                             \
+    HPDDM_F77(C ## potrs)(uplo, n, nrhs, a, lda, b, ldb, info);                                              \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::sytrf(const char* const uplo, const int* const n, T* const a, const int* const lda,  \
+                              int* const ipiv, T* const work, const int* const lwork, int* const info) {     \
+    HPDDM_F77(C ## sytrf)(uplo, n, a, lda, ipiv, work, lwork, info);                                         \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::sytrs(const char* const uplo, const int* const n, const int* const nrhs,             \
+                              const T* const a, const int* const lda, const int* const ipiv, T* const b,     \
+                              const int* const ldb, int* const info) {                                       \
+    HPDDM_F77(C ## sytrs)(uplo, n, nrhs, a, lda, ipiv, b, ldb, info);                                        \
 }                                                                                                            \
                                                                                                              \
 template<>                                                                                                   \
@@ -385,7 +436,7 @@ inline void Wrapper<K>::csrmv(const char* const trans, const int* const m, const
         else {
             if(beta == &d__0)
                 std::fill(y, y + *m, K());
-#pragma omp parallel for private(l, i, res) schedule(static, HPDDM_GRANULARITY)
+#pragma omp parallel for private(l, i, res) schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY))
             for(i = 0; i < *m; ++i) {
                 res = K();
                 for(l = ia[i] - (N == 'F'); l < ia[i + 1] - (N == 'F'); ++l)
@@ -456,7 +507,7 @@ inline void Wrapper<K>::csrmm(const char* const trans, const int* const m, const
 #pragma omp parallel private(res)
             {
                 res = new K[*n];
-#pragma omp for private(l) schedule(static, HPDDM_GRANULARITY)
+#pragma omp for private(l) schedule(static, Option::get().val("granularity", HPDDM_GRANULARITY))
                 for(i = 0; i < dimY; ++i) {
                     std::fill(res, res + *n, K());
                     for(l = ia[i] - (N == 'F'); l < ia[i + 1] - (N == 'F'); ++l)